@@ -0,0 +1,114 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_util.h"
+
+#include <linux/perf_event.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void counter_open(bench_counter_t *counter, uint32_t type,
+                         uint64_t config);
+static int compare_u64(const void *a, const void *b);
+
+// *****************************************************************************
+// Public code
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void bench_counter_open(bench_counter_t *counter, uint64_t hw_event) {
+    counter_open(counter, PERF_TYPE_HARDWARE, hw_event);
+}
+
+void bench_counter_open_cache(bench_counter_t *counter, uint64_t cache_event) {
+    counter_open(counter, PERF_TYPE_HW_CACHE, cache_event);
+}
+
+void bench_counter_reset(bench_counter_t *counter) {
+    if (counter->fd >= 0) {
+        ioctl(counter->fd, PERF_EVENT_IOC_RESET, 0);
+    }
+}
+
+int64_t bench_counter_read(bench_counter_t *counter) {
+    uint64_t value;
+
+    if (counter->fd < 0) {
+        return -1;
+    }
+    if (read(counter->fd, &value, sizeof(value)) != sizeof(value)) {
+        return -1;
+    }
+    return (int64_t)value;
+}
+
+void bench_counter_close(bench_counter_t *counter) {
+    if (counter->fd >= 0) {
+        close(counter->fd);
+        counter->fd = -1;
+    }
+}
+
+uint64_t bench_percentile(uint64_t *samples, size_t n, double percentile) {
+    size_t index;
+
+    if (n == 0) {
+        return 0;
+    }
+    qsort(samples, n, sizeof(samples[0]), compare_u64);
+    index = (size_t)(percentile / 100.0 * (double)(n - 1) + 0.5);
+    return samples[index];
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void counter_open(bench_counter_t *counter, uint32_t type,
+                         uint64_t config) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    counter->fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
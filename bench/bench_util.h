@@ -0,0 +1,87 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file bench_util.h
+ * @brief Timing, hardware-counter and statistics helpers shared by benchmarks.
+ */
+
+#ifndef _BENCH_UTIL_H_
+#define _BENCH_UTIL_H_
+
+// *****************************************************************************
+// Includes
+
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief A user-space hardware event counter for the calling thread.
+ *
+ * `fd` is -1 when the counter could not be opened (no PMU, or restricted by
+ * `perf_event_paranoid`); reads then return -1 so callers can print "n/a".
+ */
+typedef struct {
+    int fd;
+} bench_counter_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Returns CLOCK_MONOTONIC in nanoseconds.
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief Opens a hardware counter (`PERF_COUNT_HW_*`) for the calling thread.
+ */
+void bench_counter_open(bench_counter_t *counter, uint64_t hw_event);
+
+/**
+ * @brief Opens a cache counter (`PERF_TYPE_HW_CACHE` encoding:
+ * `id | op << 8 | result << 16`) for the calling thread.
+ */
+void bench_counter_open_cache(bench_counter_t *counter, uint64_t cache_event);
+
+/**
+ * @brief Resets the counter to zero.
+ */
+void bench_counter_reset(bench_counter_t *counter);
+
+/**
+ * @brief Reads the counter, or returns -1 if it is unavailable.
+ */
+int64_t bench_counter_read(bench_counter_t *counter);
+
+/**
+ * @brief Closes the counter.
+ */
+void bench_counter_close(bench_counter_t *counter);
+
+/**
+ * @brief Sorts `samples` in place and returns the given percentile (0..100).
+ */
+uint64_t bench_percentile(uint64_t *samples, size_t n, double percentile);
+
+#endif /* _BENCH_UTIL_H_ */
@@ -0,0 +1,190 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file cold.c
+ * @brief I-cache cost of instrumented hot code, with and without cold hints.
+ *
+ * Builds N_HOT_FNS small functions, each carrying three log sites that are
+ * suppressed at run time, and calls them round-robin so that their combined
+ * hot code competes for the L1 instruction cache.  Built twice by the
+ * Makefile: as is, and with `-DMU_LOG_NO_COLD_HINTS`, where each site's
+ * argument marshalling stays inline in the hot function.  Prints
+ *
+ *   <label> ns/call <ns> l1i_misses/call <n|n/a>
+ *
+ * `cold_report.sh` adds the hot and cold code bytes of the functions.
+ *
+ * usage: cold [-n rounds] <label>
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_util.h"
+#include "mu_log.h"
+
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_HOT_FNS 512
+#define DEFAULT_ROUNDS 2000
+#define N_RUNS 5
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+#define SITE(level, format, ...) level(format, __VA_ARGS__)
+#else
+#define SITE(level, format, ...) level(format)
+#endif
+
+/**
+ * A hot function: a little arithmetic with a trace site on entry, a debug
+ * site in the middle and an error site on an impossible branch.
+ */
+#define HOT_FN(n)                                                              \
+    __attribute__((noinline)) uint64_t hot_##n(uint64_t x) {                   \
+        SITE(MU_LOG_TRACE, "hot_%d: x=%lu", n, (unsigned long)x);              \
+        x = x * 6364136223846793005u + (n);                                    \
+        SITE(MU_LOG_DEBUG, "hot_%d: mixed=%lx shift=%d", n,                    \
+             (unsigned long)x, (int)(x >> 60));                                \
+        x ^= x >> 29;                                                          \
+        if (x == (uint64_t)(n)) {                                              \
+            SITE(MU_LOG_ERROR, "hot_%d: fixed point %lu %s", n,                \
+                 (unsigned long)x, "unexpected");                              \
+        }                                                                      \
+        return x;                                                              \
+    }
+
+#define X8(M, b)                                                               \
+    M(b##0) M(b##1) M(b##2) M(b##3) M(b##4) M(b##5) M(b##6) M(b##7)
+#define X64(M, b)                                                              \
+    X8(M, b##0) X8(M, b##1) X8(M, b##2) X8(M, b##3)                            \
+    X8(M, b##4) X8(M, b##5) X8(M, b##6) X8(M, b##7)
+#define X512(M)                                                                \
+    X64(M, 1) X64(M, 2) X64(M, 3) X64(M, 4)                                    \
+    X64(M, 5) X64(M, 6) X64(M, 7) X64(M, 10)
+
+#define FN_ENTRY(n) hot_##n,
+
+typedef uint64_t (*hot_fn_t)(uint64_t);
+
+// *****************************************************************************
+// Private (forward) declarations
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int null_sink(mu_log_level_t level, const char *format, va_list ap);
+#else
+static int null_sink(mu_log_level_t level, const char *message);
+#endif
+
+// *****************************************************************************
+// Hot functions
+
+X512(HOT_FN)
+
+// *****************************************************************************
+// Private (static) storage
+
+static hot_fn_t s_hot_fns[N_HOT_FNS] = {X512(FN_ENTRY)};
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int rounds = DEFAULT_ROUNDS;
+    const char *label;
+    bench_counter_t misses;
+    double best_ns = 0;
+    int64_t best_misses = -1;
+    volatile uint64_t sink = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n') {
+            rounds = atoi(optarg);
+        } else {
+            fprintf(stderr, "usage: %s [-n rounds] <label>\n", argv[0]);
+            return 2;
+        }
+    }
+    label = optind < argc ? argv[optind] : "cold";
+
+    // Sites stay suppressed: the case the hints are meant to make cheap.
+    MU_LOG_SET_FN(null_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_FATAL);
+
+    bench_counter_open_cache(&misses, PERF_COUNT_HW_CACHE_L1I |
+                                          PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                                          PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    for (int run = 0; run < N_RUNS; run++) {
+        uint64_t x = (uint64_t)run;
+        uint64_t start;
+        double ns;
+        int64_t n_misses;
+
+        bench_counter_reset(&misses);
+        start = bench_now_ns();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < N_HOT_FNS; i++) {
+                x = s_hot_fns[i](x);
+            }
+        }
+        ns = (double)(bench_now_ns() - start) / ((double)rounds * N_HOT_FNS);
+        n_misses = bench_counter_read(&misses);
+        sink += x;
+        if (run == 0 || ns < best_ns) {
+            best_ns = ns;
+        }
+        if (n_misses >= 0 && (best_misses < 0 || n_misses < best_misses)) {
+            best_misses = n_misses;
+        }
+    }
+    bench_counter_close(&misses);
+
+    printf("%s ns/call %.2f l1i_misses/call ", label, best_ns);
+    if (best_misses < 0) {
+        printf("n/a\n");
+    } else {
+        printf("%.3f\n", (double)best_misses / ((double)rounds * N_HOT_FNS));
+    }
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int null_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)format;
+    (void)ap;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#else
+static int null_sink(mu_log_level_t level, const char *message) {
+    (void)message;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#endif
@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# Hot and cold code bytes of the instrumented functions in a cold benchmark
+# binary, followed by its timing and I-cache line.
+#
+# usage: cold_report.sh <label> <cold binary> [cold args...]
+#
+# "hot" is the sum of the hot_<n> symbols, i.e. what the round-robin loop has
+# to keep in the instruction cache; "cold" is the sum of the hot_<n>.cold
+# parts the compiler split out into .text.unlikely.  Honors $NM.
+
+set -e
+
+NM=${NM:-nm}
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <label> <cold binary> [cold args...]" >&2
+    exit 2
+fi
+label=$1
+bin=$2
+shift 2
+
+"$NM" -S -t d "$bin" | awk -v label="$label" '
+    NF == 4 && $4 ~ /^hot_[0-9]+$/ { hot += $2; n++ }
+    NF == 4 && $4 ~ /^hot_[0-9]+\.cold$/ { cold += $2 }
+    END {
+        printf "%s hot_bytes %d cold_bytes %d hot_bytes/fn %.1f\n",
+            label, hot, cold, n ? hot / n : 0
+    }'
+"$bin" "$@" "$label"
@@ -0,0 +1,48 @@
+#!/bin/sh
+#
+# Compare measurements (instruction counts, section sizes) against a baseline.
+#
+# usage: compare_baseline.sh <baseline> <current> [tolerance]
+#
+# Both files hold lines of the form `<key> <value>`; lines starting with `#`
+# are ignored.  A key fails when its value exceeds the baseline by more than
+# `tolerance` (default 0), and when a baseline key is missing from the current
+# file (a scenario that crashed or was dropped).  Improvements and keys missing
+# from the baseline are reported but do not fail.
+
+set -e
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <baseline> <current> [tolerance]" >&2
+    exit 2
+fi
+
+awk -v tol="${3:-0}" '
+    /^#/ || NF < 2 { next }
+    FILENAME == ARGV[1] { base[$1] = $2; next }
+    {
+        seen[$1] = 1
+        if (!($1 in base)) {
+            printf "  NEW %-28s %8d\n", $1, $2
+            next
+        }
+        delta = $2 - base[$1]
+        if (delta > tol) {
+            printf "FAIL %-28s %8d -> %8d (%+d)\n", $1, base[$1], $2, delta
+            failed = 1
+        } else if (delta < 0) {
+            printf "  OK %-28s %8d -> %8d (%+d)\n", $1, base[$1], $2, delta
+        } else {
+            printf "  OK %-28s %8d\n", $1, $2
+        }
+    }
+    END {
+        for (key in base) {
+            if (!(key in seen)) {
+                printf "FAIL %-28s %8d -> missing\n", key, base[key]
+                failed = 1
+            }
+        }
+        exit failed
+    }
+' "$1" "$2"
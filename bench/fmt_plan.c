@@ -0,0 +1,108 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file fmt_plan.c
+ * @brief Formatter cost per call, with and without the render-plan cache.
+ *
+ * Renders a handful of typical log formats round-robin into a buffer with
+ * `mu_log_fmt_snprintf()`.  Built twice by the Makefile: with
+ * `MU_LOG_FMT_PLANS=0` and with a plan cache.  Prints
+ *
+ *   <label> ns/call <ns> hit_rate <percent>
+ *
+ * usage: fmt_plan [-n rounds] <label>
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_util.h"
+#include "mu_log_fmt.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEFAULT_ROUNDS 200000
+#define N_RUNS 5
+#define N_FORMATS 4
+
+// *****************************************************************************
+// Private (static) storage
+
+static volatile size_t s_sink;
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int rounds = DEFAULT_ROUNDS;
+    const char *label;
+    double best_ns = 0;
+    size_t hits, misses;
+    char buf[128];
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n') {
+            rounds = atoi(optarg);
+        } else {
+            fprintf(stderr, "usage: %s [-n rounds] <label>\n", argv[0]);
+            return 2;
+        }
+    }
+    label = optind < argc ? argv[optind] : "fmt_plan";
+
+    for (int run = 0; run < N_RUNS; run++) {
+        uint64_t start = bench_now_ns();
+        double ns;
+
+        for (int r = 0; r < rounds; r++) {
+            s_sink += (size_t)mu_log_fmt_snprintf(
+                buf, sizeof(buf), "request %u from %s took %d us", r,
+                "client-7", r & 1023);
+            s_sink += (size_t)mu_log_fmt_snprintf(
+                buf, sizeof(buf), "queue depth %5d, head=%08x", r & 255, r);
+            s_sink += (size_t)mu_log_fmt_snprintf(
+                buf, sizeof(buf), "%s: retry %d of %d after %lu ms", "upload",
+                r & 3, 3, (unsigned long)r);
+            s_sink += (size_t)mu_log_fmt_snprintf(
+                buf, sizeof(buf), "state %s -> %s", "idle", "running");
+        }
+        ns = (double)(bench_now_ns() - start) / ((double)rounds * N_FORMATS);
+        if (run == 0 || ns < best_ns) {
+            best_ns = ns;
+        }
+    }
+
+    mu_log_fmt_plan_stats(&hits, &misses);
+    printf("%s ns/call %.2f hit_rate %.4f%%\n", label, best_ns,
+           hits + misses > 0 ? 100.0 * (double)hits / (double)(hits + misses)
+                             : 0.0);
+    return 0;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,53 @@
+#!/bin/sh
+#
+# Compare the footprint of mu_log's stdio-free formatter with libc's printf.
+#
+# usage: fmt_size.sh <mu_log_fmt.c> <inc_dir> [libc.a]
+#
+# Compiles mu_log_fmt.c for each logging mode with -Os and reports its code
+# size and a stack bound: the formatter does not recurse, so the sum of all its
+# frames (-fstack-usage) bounds its stack use, excluding the putc hook.  When a static
+# libc archive is given, the code size of its printf engine (the archive
+# members vprintf/vfprintf depend on) is reported for comparison.
+#
+# Honors $CC and $SIZE for cross toolchains.
+
+set -e
+
+CC=${CC:-gcc}
+SIZE=${SIZE:-size}
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <mu_log_fmt.c> <inc_dir> [libc.a]" >&2
+    exit 2
+fi
+src=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+inc=$(cd "$2" && pwd)
+libc=$3
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+# text+rodata of an object, in bytes
+code_size() {
+    "$SIZE" -A "$1" | awk '$1 ~ /^\.(text|rodata)/ { n += $2 } END { print n + 0 }'
+}
+
+for mode in MU_LOG_ENABLE MU_LOG_ENABLE_FORMATTED; do
+    (cd "$tmp" && "$CC" -Os -fstack-usage -D$mode -I"$inc" -c "$src" -o fmt.o)
+    stack=$(awk -F'\t' '{ n += $2 } END { print n + 0 }' "$tmp/fmt.su")
+    printf "%-38s %7d bytes code, %4d bytes stack bound\n" \
+        "mu_log_fmt ($mode)" "$(code_size "$tmp/fmt.o")" "$stack"
+done
+
+if [ -n "$libc" ] && [ -f "$libc" ]; then
+    total=0
+    for member in vprintf.o vfprintf.o vfprintf-internal.o printf_fp.o \
+                  printf_fphex.o printf-parsemb.o reg-printf.o; do
+        if (cd "$tmp" && ar x "$libc" "$member" 2>/dev/null) &&
+           [ -f "$tmp/$member" ]; then
+            total=$((total + $(code_size "$tmp/$member")))
+        fi
+    done
+    printf "%-38s %7d bytes code\n" "libc printf engine ($(basename "$libc"))" "$total"
+fi
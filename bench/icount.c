@@ -0,0 +1,308 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file icount.c
+ * @brief Deterministic instruction-count benchmark for mu_log.
+ *
+ * Each scenario runs in a forked child.  The child runs a warm-up pass, then
+ * executes the scenario `ICOUNT_ITERATIONS` times between two `SIGSTOP`
+ * markers.  The parent counts user-space instructions retired between the
+ * markers, either by single-stepping the child with `ptrace()` (default, works
+ * without hardware counters) or with `perf_event_open()` (`-p`).  The count of
+ * an empty scenario is subtracted so only mu_log's share remains.
+ *
+ * Output is one line per scenario: `<mode>.<scenario> <instructions/call>`,
+ * suitable for comparison against `icount_baseline.txt` with
+ * `compare_baseline.sh`.
+ *
+ * `icount -r <scenario>` runs a single scenario in-process without markers,
+ * for use under `valgrind --tool=callgrind` or `perf stat -e instructions:u`.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <linux/perf_event.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/ptrace.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define ICOUNT_ITERATIONS 100
+
+#if defined(MU_LOG_ENABLE_FORMATTED)
+#define ICOUNT_MODE "formatted"
+#elif defined(MU_LOG_PRERENDER)
+#define ICOUNT_MODE "prerender"
+#elif defined(MU_LOG_ENABLE)
+#define ICOUNT_MODE "simple"
+#else
+#define ICOUNT_MODE "disabled"
+#endif
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(void);
+} scenario_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void setup_none(void);
+static void setup_null_sink(void);
+static void setup_stdout_sink(void);
+static void run_empty(void);
+static void run_suppressed(void);
+static void run_will_log(void);
+static void run_emitted(void);
+
+static long count_instructions(const scenario_t *scenario, bool use_perf);
+
+// *****************************************************************************
+// Private (static) storage
+
+static const scenario_t s_scenarios[] = {
+    {"empty", setup_none, run_empty},
+    {"suppressed", setup_null_sink, run_suppressed},
+    {"will_log", setup_null_sink, run_will_log},
+    {"null_sink", setup_null_sink, run_emitted},
+    {"stdout_sink", setup_stdout_sink, run_emitted},
+};
+#define N_SCENARIOS (sizeof(s_scenarios) / sizeof(s_scenarios[0]))
+
+static volatile int s_sink;
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char *argv[]) {
+    bool use_perf = false;
+    int opt;
+    long empty;
+
+    while ((opt = getopt(argc, argv, "pr:")) != -1) {
+        switch (opt) {
+        case 'p':
+            use_perf = true;
+            break;
+        case 'r':
+            for (size_t i = 0; i < N_SCENARIOS; i++) {
+                if (strcmp(optarg, s_scenarios[i].name) == 0) {
+                    s_scenarios[i].setup();
+                    for (int j = 0; j < ICOUNT_ITERATIONS; j++) {
+                        s_scenarios[i].run();
+                    }
+                    return 0;
+                }
+            }
+            fprintf(stderr, "unknown scenario: %s\n", optarg);
+            return 2;
+        default:
+            fprintf(stderr, "usage: %s [-p] [-r scenario]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    empty = count_instructions(&s_scenarios[0], use_perf);
+    if (empty < 0) {
+        return 1;
+    }
+    for (size_t i = 1; i < N_SCENARIOS; i++) {
+        long n = count_instructions(&s_scenarios[i], use_perf);
+        if (n < 0) {
+            return 1;
+        }
+        printf("%s.%s %ld\n", ICOUNT_MODE, s_scenarios[i].name,
+               (n - empty) / ICOUNT_ITERATIONS);
+    }
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+#if defined(MU_LOG_ENABLE_FORMATTED)
+static int null_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)format;
+    (void)ap;
+    if (MU_LOG_WILL_LOG(level)) {
+        s_sink = level;
+    }
+    return 0;
+}
+#elif defined(MU_LOG_ENABLE)
+static int null_sink(mu_log_level_t level, const char *message) {
+    (void)message;
+    if (MU_LOG_WILL_LOG(level)) {
+        s_sink = level;
+    }
+    return 0;
+}
+#endif
+
+static void setup_none(void) {}
+
+static void setup_null_sink(void) {
+    MU_LOG_SET_FN(null_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+static void setup_stdout_sink(void) {
+    if (freopen("/dev/null", "w", stdout) == NULL) {
+        exit(1);
+    }
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+static void run_empty(void) {
+    s_sink = 0;
+}
+
+static void run_suppressed(void) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_DEBUG("suppressed %d", s_sink);
+#else
+    MU_LOG_DEBUG("suppressed");
+#endif
+}
+
+static void run_will_log(void) {
+    s_sink = MU_LOG_WILL_LOG(MU_LOG_LEVEL_DEBUG);
+}
+
+static void run_emitted(void) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_INFO("emitted %d", s_sink);
+#else
+    MU_LOG_INFO("emitted");
+#endif
+}
+
+/**
+ * @brief Child side: warm up, then run the scenario between two stop markers.
+ */
+static void run_child(const scenario_t *scenario) {
+    scenario->setup();
+    scenario->run(); // warm-up: resolve PLT entries, prime stdio buffers
+    raise(SIGSTOP);
+    for (int i = 0; i < ICOUNT_ITERATIONS; i++) {
+        scenario->run();
+    }
+    raise(SIGSTOP);
+    fflush(stdout);
+    _exit(0);
+}
+
+static long count_by_ptrace(pid_t pid) {
+    long steps = 0;
+    int status;
+
+    for (;;) {
+        if (ptrace(PTRACE_SINGLESTEP, pid, NULL, NULL) < 0) {
+            perror("ptrace");
+            return -1;
+        }
+        if (waitpid(pid, &status, 0) < 0 || !WIFSTOPPED(status)) {
+            fprintf(stderr, "child exited before end marker\n");
+            return -1;
+        }
+        if (WSTOPSIG(status) == SIGSTOP) {
+            return steps;
+        }
+        steps++;
+    }
+}
+
+static long count_by_perf(pid_t pid) {
+    struct perf_event_attr attr;
+    uint64_t count;
+    int status;
+    int fd;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = syscall(SYS_perf_event_open, &attr, pid, -1, -1, 0);
+    if (fd < 0) {
+        perror("perf_event_open");
+        return -1;
+    }
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ptrace(PTRACE_CONT, pid, NULL, NULL);
+    if (waitpid(pid, &status, 0) < 0 || !WIFSTOPPED(status)) {
+        close(fd);
+        return -1;
+    }
+    if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    return (long)count;
+}
+
+/**
+ * @brief Count user-space instructions retired by one scenario.
+ *
+ * @return The instruction count for `ICOUNT_ITERATIONS` runs, or -1 on error.
+ */
+static long count_instructions(const scenario_t *scenario, bool use_perf) {
+    pid_t pid;
+    int status;
+    long count;
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+        run_child(scenario);
+    }
+
+    // wait for the start marker
+    if (waitpid(pid, &status, 0) < 0 || !WIFSTOPPED(status)) {
+        return -1;
+    }
+    count = use_perf ? count_by_perf(pid) : count_by_ptrace(pid);
+
+    ptrace(PTRACE_CONT, pid, NULL, NULL);
+    waitpid(pid, &status, 0);
+    return count;
+}
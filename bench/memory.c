@@ -0,0 +1,216 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file memory.c
+ * @brief Memory-footprint benchmark for each backend configuration.
+ *
+ * For every backend this reports:
+ * - `state_B`: static logger state,
+ * - `buffer_B`: heap claimed while setting up and warming up the backend
+ *   (e.g. the stdio buffer behind `mu_log_stdout_fn`),
+ * - `allocs`: heap allocations during the measured records (should be 0),
+ * - `B/record`: heap bytes allocated per record,
+ * - `rss_kB` and `drss_kB`: resident set size after the run, and its growth
+ *   across the measured records.
+ *
+ * Heap use is observed by interposing `malloc()` and friends (glibc).
+ *
+ * usage: memory [-n records]
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+typedef struct {
+    const char *name;
+    size_t state_bytes;
+    void (*setup)(void);
+} backend_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void setup_null(void);
+static void setup_stdout(void);
+static size_t rss_kb(void);
+static void log_record(size_t i);
+
+// *****************************************************************************
+// Private (static) storage
+
+static const backend_t s_backends[] = {
+    {"null", sizeof(mu_log_t), setup_null},
+    {"stdout", sizeof(mu_log_t), setup_stdout},
+};
+#define N_BACKENDS (sizeof(s_backends) / sizeof(s_backends[0]))
+
+static size_t s_allocs;
+static size_t s_alloc_bytes;
+
+// *****************************************************************************
+// Heap interposition
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *ptr);
+
+static void *count_alloc(void *ptr) {
+    if (ptr != NULL) {
+        s_allocs++;
+        s_alloc_bytes += malloc_usable_size(ptr);
+    }
+    return ptr;
+}
+
+void *malloc(size_t size) {
+    return count_alloc(__libc_malloc(size));
+}
+
+void *calloc(size_t n, size_t size) {
+    return count_alloc(__libc_calloc(n, size));
+}
+
+void *realloc(void *ptr, size_t size) {
+    return count_alloc(__libc_realloc(ptr, size));
+}
+
+void *memalign(size_t alignment, size_t size) {
+    return count_alloc(__libc_memalign(alignment, size));
+}
+
+void free(void *ptr) {
+    __libc_free(ptr);
+}
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char *argv[]) {
+    size_t records = 100000;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n') {
+            records = strtoul(optarg, NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n records]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // results go to stderr; stdout carries the log output
+    fprintf(stderr, "records=%zu\n", records);
+    fprintf(stderr, "%-10s %8s %9s %7s %9s %8s %8s\n", "backend", "state_B",
+            "buffer_B", "allocs", "B/record", "rss_kB", "drss_kB");
+    if (freopen("/dev/null", "w", stdout) == NULL) {
+        perror("/dev/null");
+        return 1;
+    }
+
+    for (size_t i = 0; i < N_BACKENDS; i++) {
+        const backend_t *backend = &s_backends[i];
+        size_t buffer_bytes, rss_before, rss_after, allocs, alloc_bytes;
+
+        s_allocs = 0;
+        s_alloc_bytes = 0;
+        backend->setup();
+        log_record(0);
+        buffer_bytes = s_alloc_bytes;
+
+        rss_before = rss_kb();
+        s_allocs = 0;
+        s_alloc_bytes = 0;
+        for (size_t r = 0; r < records; r++) {
+            log_record(r);
+        }
+        fflush(stdout);
+        allocs = s_allocs;
+        alloc_bytes = s_alloc_bytes;
+        rss_after = rss_kb();
+
+        fprintf(stderr, "%-10s %8zu %9zu %7zu %9.2f %8zu %+8ld\n",
+                backend->name, backend->state_bytes, buffer_bytes, allocs,
+                records ? (double)alloc_bytes / (double)records : 0.0,
+                rss_after, (long)rss_after - (long)rss_before);
+    }
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+#if defined(MU_LOG_ENABLE_FORMATTED)
+static int null_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)format;
+    (void)ap;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#else
+static int null_sink(mu_log_level_t level, const char *message) {
+    (void)message;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#endif
+
+static void setup_null(void) {
+    MU_LOG_SET_FN(null_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+static void setup_stdout(void) {
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+static size_t rss_kb(void) {
+    unsigned long size, resident;
+    FILE *f = fopen("/proc/self/statm", "r");
+
+    if (f == NULL) {
+        return 0;
+    }
+    if (fscanf(f, "%lu %lu", &size, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(f);
+    return resident * (size_t)sysconf(_SC_PAGESIZE) / 1024;
+}
+
+static void log_record(size_t i) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_INFO("record %zu of a typical length, value=%d", i, (int)i * 3);
+#else
+    (void)i;
+    MU_LOG_INFO("record of a typical length");
+#endif
+}
@@ -0,0 +1,287 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file observer.c
+ * @brief Observer-effect benchmark: how much does logging perturb a workload?
+ *
+ * Runs a synthetic request-processing loop (random reads and writes over a
+ * working set larger than L2) and records the latency of every request.  The
+ * loop is run once without logging to establish a baseline, then once per
+ * backend with a log call injected every `-r` requests at level `-l`.  For
+ * each run it reports the latency distribution, the shift of p99 against the
+ * baseline, whether the p99 target (`-t`) is met, and the cache misses per
+ * request when hardware counters are available.  Results are printed on
+ * stderr; stdout carries the log output (`-o`, default /dev/null).
+ *
+ * usage: observer [-n requests] [-r every_n] [-l level] [-t p99_ns]
+ *                 [-b backend] [-o path]
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_util.h"
+#include "mu_log.h"
+
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define WORKING_SET_WORDS (1u << 17) // 1 MiB of uint64_t
+#define TOUCHES_PER_REQUEST 512
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+} backend_t;
+
+typedef struct {
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t max;
+    double misses_per_request; // < 0 if unavailable
+} run_stats_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void setup_null(void);
+static void setup_stdout(void);
+static bool parse_level(const char *name, mu_log_level_t *level);
+static void run(const backend_t *backend, run_stats_t *stats);
+static void print_row(const char *name, const run_stats_t *stats,
+                      const run_stats_t *baseline);
+
+// *****************************************************************************
+// Private (static) storage
+
+static const backend_t s_backends[] = {
+    {"null", setup_null},
+    {"stdout", setup_stdout},
+};
+#define N_BACKENDS (sizeof(s_backends) / sizeof(s_backends[0]))
+
+static uint64_t *s_working_set;
+static uint64_t *s_latencies;
+static volatile uint64_t s_result;
+
+static size_t s_requests = 200000;
+static unsigned s_log_every = 1;
+static mu_log_level_t s_log_level = MU_LOG_LEVEL_INFO;
+static uint64_t s_p99_target_ns = 0;
+static const char *s_output = "/dev/null";
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char *argv[]) {
+    const char *only = NULL;
+    run_stats_t baseline;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:l:t:b:o:")) != -1) {
+        switch (opt) {
+        case 'n':
+            s_requests = strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            s_log_every = strtoul(optarg, NULL, 0);
+            if (s_log_every == 0) {
+                fprintf(stderr, "-r must be at least 1\n");
+                return 2;
+            }
+            break;
+        case 'l':
+            if (!parse_level(optarg, &s_log_level)) {
+                fprintf(stderr, "unknown level: %s\n", optarg);
+                return 2;
+            }
+            break;
+        case 't':
+            s_p99_target_ns = strtoull(optarg, NULL, 0);
+            break;
+        case 'b':
+            only = optarg;
+            break;
+        case 'o':
+            s_output = optarg;
+            break;
+        default:
+            fprintf(stderr,
+                    "usage: %s [-n requests] [-r every_n] [-l level] "
+                    "[-t p99_ns] [-b backend] [-o path]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    s_working_set = calloc(WORKING_SET_WORDS, sizeof(uint64_t));
+    s_latencies = calloc(s_requests, sizeof(uint64_t));
+    if (s_working_set == NULL || s_latencies == NULL || s_requests == 0) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+
+    fprintf(stderr, "requests=%zu log_every=%u level=%s threshold=%s\n",
+            s_requests, s_log_every, mu_log_level_name(s_log_level),
+            mu_log_level_name(MU_LOG_LEVEL_INFO));
+    fprintf(stderr, "%-10s %9s %9s %9s %9s %9s %11s %s\n", "backend",
+            "p50_ns", "p99_ns", "p99.9_ns", "max_ns", "dp99_ns", "misses/req",
+            "target");
+
+    run(NULL, &baseline); // warm-up
+    run(NULL, &baseline);
+    print_row("none", &baseline, &baseline);
+
+    for (size_t i = 0; i < N_BACKENDS; i++) {
+        run_stats_t stats;
+        if (only != NULL && strcmp(only, s_backends[i].name) != 0) {
+            continue;
+        }
+        s_backends[i].setup();
+        run(&s_backends[i], &stats);
+        print_row(s_backends[i].name, &stats, &baseline);
+    }
+
+    free(s_latencies);
+    free(s_working_set);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+#if defined(MU_LOG_ENABLE_FORMATTED)
+static int null_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)format;
+    (void)ap;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#else
+static int null_sink(mu_log_level_t level, const char *message) {
+    (void)message;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#endif
+
+static void setup_null(void) {
+    MU_LOG_SET_FN(null_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+static void setup_stdout(void) {
+    fflush(stdout);
+    if (freopen(s_output, "w", stdout) == NULL) {
+        perror(s_output);
+        exit(1);
+    }
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+static bool parse_level(const char *name, mu_log_level_t *level) {
+    for (int i = MU_LOG_LEVEL_TRACE; i <= MU_LOG_LEVEL_FATAL; i++) {
+        if (strcasecmp(name, mu_log_level_name(i)) == 0) {
+            *level = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief One synthetic request: a dependent walk over the working set.
+ */
+static uint64_t process_request(uint64_t seed) {
+    uint64_t x = seed;
+    for (int i = 0; i < TOUCHES_PER_REQUEST; i++) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        uint64_t *word = &s_working_set[(x >> 33) & (WORKING_SET_WORDS - 1)];
+        *word += x;
+        x ^= *word;
+    }
+    return x;
+}
+
+/**
+ * @brief Runs the request loop, logging through `backend` unless NULL.
+ */
+static void run(const backend_t *backend, run_stats_t *stats) {
+    bench_counter_t misses;
+    uint64_t seed = 1;
+    int64_t n_misses;
+
+    bench_counter_open(&misses, PERF_COUNT_HW_CACHE_MISSES);
+    bench_counter_reset(&misses);
+
+    for (size_t i = 0; i < s_requests; i++) {
+        uint64_t start = bench_now_ns();
+        seed = process_request(seed);
+        if (backend != NULL && (i % s_log_every) == 0) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+            MU_LOG(s_log_level, "request %zu done, seed=%llx", i,
+                   (unsigned long long)seed);
+#else
+            MU_LOG(s_log_level, "request done");
+#endif
+        }
+        s_latencies[i] = bench_now_ns() - start;
+    }
+    s_result = seed;
+
+    n_misses = bench_counter_read(&misses);
+    bench_counter_close(&misses);
+    fflush(stdout);
+
+    stats->misses_per_request =
+        n_misses < 0 ? -1.0 : (double)n_misses / (double)s_requests;
+    stats->p50 = bench_percentile(s_latencies, s_requests, 50.0);
+    stats->p99 = bench_percentile(s_latencies, s_requests, 99.0);
+    stats->p999 = bench_percentile(s_latencies, s_requests, 99.9);
+    stats->max = s_latencies[s_requests - 1];
+}
+
+static void print_row(const char *name, const run_stats_t *stats,
+                      const run_stats_t *baseline) {
+    const char *target = "-";
+    char misses[16];
+
+    if (s_p99_target_ns != 0) {
+        target = stats->p99 <= s_p99_target_ns ? "met" : "MISSED";
+    }
+    if (stats->misses_per_request < 0) {
+        snprintf(misses, sizeof(misses), "n/a");
+    } else {
+        snprintf(misses, sizeof(misses), "%.1f", stats->misses_per_request);
+    }
+    // results go to stderr once stdout is redirected to the log destination
+    fprintf(stderr, "%-10s %9llu %9llu %9llu %9llu %+9lld %11s %s\n", name,
+            (unsigned long long)stats->p50, (unsigned long long)stats->p99,
+            (unsigned long long)stats->p999, (unsigned long long)stats->max,
+            (long long)stats->p99 - (long long)baseline->p99, misses, target);
+}
@@ -0,0 +1,166 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file pipe.c
+ * @brief Writer CPU time for high-volume output to a pipe, gifting pages
+ * versus copying.
+ *
+ * A child process stands in for the log collector and reads the pipe to EOF.
+ * The parent hands N pre-rendered lines, as the ring's drain would, to
+ * `mu_log_pipe_writer()`, flushing every 1000 lines, and measures its own
+ * user and system time.  Prints
+ *
+ *   <label> cpu_ns/line <ns> sys_ns/line <ns> MB/s <rate> spliced <percent>
+ *
+ * usage: pipe [-n lines] splice|copy
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "bench_util.h"
+#include "mu_log_pipe.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEFAULT_LINES 2000000
+#define LINES_PER_DRAIN 1000
+#define N_VARIANTS 256
+#define LINE_MAX 128
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void collect(int fd);
+static uint64_t cpu_ns(const struct rusage *usage, bool sys_only);
+
+// *****************************************************************************
+// Private (static) storage
+
+static char s_lines[N_VARIANTS][LINE_MAX];
+static size_t s_lens[N_VARIANTS];
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char **argv) {
+    int lines = DEFAULT_LINES;
+    const char *label;
+    struct rusage before, after;
+    mu_log_pipe_stats_t stats;
+    uint64_t start, elapsed;
+    int fds[2];
+    pid_t child;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n') {
+            lines = atoi(optarg);
+        } else {
+            fprintf(stderr, "usage: %s [-n lines] splice|copy\n", argv[0]);
+            return 2;
+        }
+    }
+    label = optind < argc ? argv[optind] : "splice";
+    for (int i = 0; i < N_VARIANTS; i++) {
+        s_lens[i] = (size_t)snprintf(
+            s_lines[i], LINE_MAX,
+            "req=%08d status=200 bytes=%d path=/api/v1/items", i * 7919,
+            (i * 31) & 4095);
+    }
+
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return 1;
+    }
+    child = fork();
+    if (child == 0) {
+        close(fds[1]);
+        collect(fds[0]);
+        _exit(0);
+    }
+    close(fds[0]);
+    if (!mu_log_pipe_init(fds[1], strcmp(label, "splice") == 0)) {
+        fprintf(stderr, "mu_log_pipe_init failed\n");
+        return 1;
+    }
+
+    getrusage(RUSAGE_SELF, &before);
+    start = bench_now_ns();
+    for (int i = 0; i < lines; i++) {
+        int v = i % N_VARIANTS;
+        mu_log_pipe_writer(MU_LOG_LEVEL_INFO, s_lines[v], s_lens[v], NULL);
+        if (i % LINES_PER_DRAIN == LINES_PER_DRAIN - 1) {
+            mu_log_pipe_flush();
+        }
+    }
+    mu_log_pipe_close();
+    elapsed = bench_now_ns() - start;
+    getrusage(RUSAGE_SELF, &after);
+    close(fds[1]);
+    waitpid(child, NULL, 0);
+
+    mu_log_pipe_stats(&stats);
+    printf("%s cpu_ns/line %.1f sys_ns/line %.1f MB/s %.0f spliced %.0f%%\n",
+           label,
+           (double)(cpu_ns(&after, false) - cpu_ns(&before, false)) / lines,
+           (double)(cpu_ns(&after, true) - cpu_ns(&before, true)) / lines,
+           (double)(stats.spliced + stats.written) / 1e6 / (elapsed / 1e9),
+           100.0 * (double)stats.spliced /
+               (double)(stats.spliced + stats.written));
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief The collector: reads and discards until EOF.
+ */
+static void collect(int fd) {
+    static char buf[65536];
+
+    while (read(fd, buf, sizeof(buf)) > 0) {
+    }
+}
+
+static uint64_t cpu_ns(const struct rusage *usage, bool sys_only) {
+    uint64_t sys = (uint64_t)usage->ru_stime.tv_sec * 1000000000u +
+                   (uint64_t)usage->ru_stime.tv_usec * 1000u;
+
+    if (sys_only) {
+        return sys;
+    }
+    return sys + (uint64_t)usage->ru_utime.tv_sec * 1000000000u +
+           (uint64_t)usage->ru_utime.tv_usec * 1000u;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,121 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file size_app.c
+ * @brief A representative application for the binary-size report.
+ *
+ * Sets up the default stdout sink and logs from a few functions at every
+ * level, the way a small firmware image would.  It is compiled under each
+ * logging mode and compile-time floor by `make size_report`.  With
+ * `SIZE_APP_PUTC` defined it uses the stdio-free `mu_log_putc_fn` instead,
+ * writing through a `write()`-based putc hook in place of a UART driver.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#ifdef SIZE_APP_PUTC
+#include "mu_log_fmt.h"
+#include <unistd.h>
+#endif
+
+// *****************************************************************************
+// Private (static) storage
+
+static volatile int s_sensor;
+
+// *****************************************************************************
+// Private (static) code
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static void sample_sensor(void) {
+    int value = s_sensor;
+    MU_LOG_TRACE("sensor raw=%d", value);
+    MU_LOG_DEBUG("sensor scaled=%d.%02d", value / 100, value % 100);
+    if (value > 1000) {
+        MU_LOG_WARN("sensor over range: %d > %d", value, 1000);
+    }
+}
+
+static void handle_command(const char *cmd, unsigned arg) {
+    MU_LOG_INFO("command %s arg=0x%04x", cmd, arg);
+    if (arg == 0) {
+        MU_LOG_ERROR("command %s: missing argument", cmd);
+    }
+}
+
+static void fail(int code) {
+    MU_LOG_FATAL("unrecoverable error %d", code);
+}
+#else
+static void sample_sensor(void) {
+    int value = s_sensor;
+    MU_LOG_TRACE("sensor sampled");
+    MU_LOG_DEBUG("sensor scaled");
+    if (value > 1000) {
+        MU_LOG_WARN("sensor over range");
+    }
+}
+
+static void handle_command(const char *cmd, unsigned arg) {
+    (void)cmd;
+    MU_LOG_INFO("command received");
+    if (arg == 0) {
+        MU_LOG_ERROR("command missing argument");
+    }
+}
+
+static void fail(int code) {
+    (void)code;
+    MU_LOG_FATAL("unrecoverable error");
+}
+#endif
+
+#ifdef SIZE_APP_PUTC
+static void uart_putc(char ch, void *arg) {
+    (void)arg;
+    (void)!write(1, &ch, 1);
+}
+#endif
+
+// *****************************************************************************
+// Public code
+
+int main(void) {
+#ifdef SIZE_APP_PUTC
+    mu_log_set_putc(uart_putc, NULL);
+    MU_LOG_SET_FN(mu_log_putc_fn);
+#else
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+#endif
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+
+    for (int i = 0; i < 3; i++) {
+        sample_sensor();
+        handle_command("reset", (unsigned)i);
+    }
+    if (s_sensor < 0) {
+        fail(s_sensor);
+    }
+    return 0;
+}
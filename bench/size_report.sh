@@ -0,0 +1,63 @@
+#!/bin/sh
+#
+# Report the footprint a logging configuration adds to an application.
+#
+# usage: size_report.sh <config> <app> <empty_app>
+#
+# `app` and `empty_app` must be linked with identical flags; everything is
+# reported as a delta against `empty_app` so start-up code and the C runtime
+# cancel out.  Output is `<config>.<section> <bytes>` for .text, .rodata,
+# .data and .bss (machine-readable, comparable with compare_baseline.sh),
+# preceded by `#` comment lines holding the per-symbol attribution and the
+# libc functions the configuration imports.  With a static or bare-metal
+# link, pulled-in libc code (e.g. the printf engine) appears directly in the
+# section totals and the symbol list.
+#
+# Honors $SIZE and $NM for cross toolchains.
+
+set -e
+
+SIZE=${SIZE:-size}
+NM=${NM:-nm}
+
+if [ $# -ne 3 ]; then
+    echo "usage: $0 <config> <app> <empty_app>" >&2
+    exit 2
+fi
+config=$1
+app=$2
+empty=$3
+
+# Sum `size -A` output into the four section classes.
+sections() {
+    "$SIZE" -A "$1" | awk '
+        $1 ~ /^\.text/ || $1 ~ /^\.plt/ || $1 ~ /^\.init/ || $1 ~ /^\.fini/ { t += $2 }
+        $1 ~ /^\.rodata/ || $1 ~ /^\.eh_frame/ { r += $2 }
+        $1 ~ /^\.data/ || $1 ~ /^\.got/ { d += $2 }
+        $1 ~ /^\.bss/ { b += $2 }
+        END { printf "text %d\nrodata %d\ndata %d\nbss %d\n", t, r, d, b }'
+}
+
+# Defined, sized symbols: "<size> <type> <name>", decimal size.
+symbols() {
+    "$NM" -S --size-sort -t d "$1" | awk 'NF == 4 { print $2 + 0, $3, $4 }'
+}
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+symbols "$empty" | awk '{ print $3 }' | sort > "$tmp/empty_syms"
+
+echo "# $config: symbols not present in the empty application"
+symbols "$app" | sort -k3 | join -1 3 -2 1 -v 1 -o 1.1,1.2,1.3 - "$tmp/empty_syms" \
+    | sort -rn | awk '{ printf "#   %7d %s %s\n", $1, $2, $3 }'
+
+echo "# $config: libc imports"
+"$NM" -u "$app" | awk '{ print $NF }' | sed 's/@.*//' | sort > "$tmp/app_imports"
+"$NM" -u "$empty" | awk '{ print $NF }' | sed 's/@.*//' | sort > "$tmp/empty_imports"
+imports=$(comm -23 "$tmp/app_imports" "$tmp/empty_imports" | tr '\n' ' ')
+echo "#   ${imports:-(none)}"
+
+sections "$empty" > "$tmp/empty_sections"
+sections "$app" | paste -d ' ' - "$tmp/empty_sections" \
+    | awk -v cfg="$config" '{ printf "%s.%s %d\n", cfg, $1, $2 - $4 }'
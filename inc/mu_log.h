@@ -12,6 +12,46 @@
  * 
  * The framework allows customization of the logging function (`mu_log_set_fn`)
  * and logging level (`mu_log_set_threshold`). When disabled, macros resolve to no-ops.
+ *
+ * **Static sink:** define `MU_LOG_STATIC_SINK` as the name of a function with
+ * the `mu_log_fn` signature (e.g. `-DMU_LOG_STATIC_SINK=uart_log_fn`) to bind
+ * the sink at build time.  `mu_log()` then calls it directly rather than
+ * through a function pointer, so it can be inlined under LTO, and
+ * `MU_LOG_SET_FN()` has no effect.
+ *
+ * **Per-module thresholds:** define `MU_LOG_MODULES` for the whole build to
+ * give every source file its own threshold, looked up by the name the file
+ * defines as `MU_LOG_MODULE` before including this header (files that define
+ * none belong to the default module).  The table lives in the mu_log_cfg
+ * configuration snapshot (see mu_log_cfg.h and mu_log_spec.h), so
+ * `src/mu_log_cfg.c` must be linked.  Each level macro then checks its
+ * file's cached threshold, re-resolving it only after the table changes.
+ *
+ * **Shared control page:** define `MU_LOG_SHM` for the whole build (Linux,
+ * GCC or Clang) to keep the global threshold, per-module overrides and a
+ * per-call-site enable bit in `mu_log_shm_page`, which `mu_log_shm_init()`
+ * shares with external tools (see mu_log_shm.h).  Level checks read the page
+ * with plain loads; `src/mu_log_shm.c` must be linked.
+ *
+ * **Routes:** define `MU_LOG_ROUTES` for the whole build (GCC or Clang) to
+ * send records straight to the mu_log_cfg sinks that take them.  Each call
+ * site caches, per level, a mask of those sinks, tagged with the
+ * configuration generation, so routing a record is one load and one compare
+ * until the next `mu_log_cfg_publish()`.  The sink set with `mu_log_set_fn()`
+ * is then unused; `src/mu_log_cfg.c` must be linked.
+ *
+ * **Pre-rendered lines:** in simple mode (`MU_LOG_ENABLE`), define
+ * `MU_LOG_PRERENDER` to have `MU_LOG_TRACE()` .. `MU_LOG_FATAL()` join the
+ * level prefix, message and newline into one string literal at compile time.
+ * With `mu_log_stdout_fn` installed, a line is then written with a single
+ * `fwrite()` of a constant whose length is known; other sinks get the bare
+ * message as before.  Those macros then accept only string literals; use
+ * `MU_LOG(level, message)` for messages built at run time.
+ *
+ * **Single-header build:** instead of compiling `src/mu_log.c`, define
+ * `MU_LOG_IMPLEMENTATION` in exactly one source file before including this
+ * header.  Either way the threshold check (`mu_log_will_log()`) is inline, so a
+ * suppressed log call costs a load and a compare at the call site.
  */
 
 #ifndef _MU_LOG_H_
@@ -21,6 +61,7 @@
 // Includes
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // *****************************************************************************
 // C++ Compatibility
@@ -53,6 +94,71 @@ typedef enum {
 
 #define MU_LOG_DEFAULT_LEVEL MU_LOG_LEVEL_INFO /**< Default log level */
 
+/**
+ * @brief Compile-time logging floor.
+ *
+ * Level macros (`MU_LOG_TRACE()` ... `MU_LOG_FATAL()`) below this level
+ * compile to nothing, including their strings and argument marshalling,
+ * regardless of the runtime threshold.  Defaults to `MU_LOG_LEVEL_TRACE`
+ * (everything compiled in).  Example:
+ * `-DMU_LOG_COMPILE_THRESHOLD=MU_LOG_LEVEL_WARN`
+ */
+#ifndef MU_LOG_COMPILE_THRESHOLD
+#define MU_LOG_COMPILE_THRESHOLD MU_LOG_LEVEL_TRACE
+#endif
+
+/**
+ * @brief Bytes of static storage for records logged before a sink is set.
+ *
+ * When nonzero, the installed sink until the first `mu_log_set_fn()` is
+ * `mu_log_preinit_fn`, which keeps each record's level and text in this
+ * buffer; the first real sink receives them, in order, followed by a WARN
+ * record counting any that did not fit.  Off by default: capturing a
+ * formatted record pulls `vsnprintf` into the image, which stdio-free builds
+ * must not do.  At 0 the logger starts with no sink and early records are
+ * discarded.  Ignored with `MU_LOG_STATIC_SINK`.
+ */
+#ifndef MU_LOG_PREINIT_SIZE
+#define MU_LOG_PREINIT_SIZE 0
+#endif
+
+/**
+ * @brief Keeps emission code out of the caller's hot path.
+ *
+ * With GCC or Clang the level macros wrap their threshold check in
+ * `__builtin_expect(..., 0)` and `mu_log()` is declared `cold`, so the
+ * compiler moves each site's argument marshalling and call into
+ * `.text.unlikely` (the `<fn>.cold` part of the caller) instead of leaving it
+ * inline between hot instructions.  Define `MU_LOG_NO_COLD_HINTS` to disable.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(MU_LOG_NO_COLD_HINTS)
+#define MU_LOG_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define MU_LOG_COLD __attribute__((cold, noinline))
+#else
+#define MU_LOG_UNLIKELY(x) (x)
+#define MU_LOG_COLD
+#endif
+
+/**
+ * @brief Loads and stores for the per-file and per-site caches, which every
+ * thread logging from that file shares.
+ *
+ * A cache's fields are written first and its generation is stored last with
+ * release; a reader that loads the generation with acquire also sees the
+ * fields it covers.  Other compilers get plain accesses.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define MU_LOG_LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define MU_LOG_LOAD_RELAXED(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define MU_LOG_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define MU_LOG_STORE_RELAXED(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#else
+#define MU_LOG_LOAD_ACQUIRE(p) (*(p))
+#define MU_LOG_LOAD_RELAXED(p) (*(p))
+#define MU_LOG_STORE_RELEASE(p, v) (*(p) = (v))
+#define MU_LOG_STORE_RELAXED(p, v) (*(p) = (v))
+#endif
+
 /**
  * @typedef mu_log_fn
  * @brief Function pointer type for logging output.
@@ -66,6 +172,17 @@ typedef int (*mu_log_fn)(mu_log_level_t level, const char *format, va_list ap);
 typedef int (*mu_log_fn)(mu_log_level_t level, const char *message);
 #endif
 
+#ifdef MU_LOG_STATIC_SINK
+/** The sink bound at build time (see "Static sink" above). */
+int MU_LOG_STATIC_SINK(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+#endif
+
 /**
  * @struct mu_log_t
  * @brief Represents the global logger instance.
@@ -75,15 +192,92 @@ typedef struct {
     mu_log_level_t threshold;  /**< Minimum severity level */
 } mu_log_t;
 
+/**
+ * @brief The global logger, read by the inline `mu_log_will_log()`.
+ *
+ * Treat as read-only; use `mu_log_set_fn()` / `mu_log_set_threshold()`.
+ */
+extern mu_log_t mu_log_logger;
+
+#ifdef MU_LOG_SHM
+#include <stdint.h>
+
+#ifndef MU_LOG_SHM_MAX_MODULES
+#define MU_LOG_SHM_MAX_MODULES 16 /**< Modules listed in the control page */
+#endif
+
+#ifndef MU_LOG_SHM_MAX_SITES
+#define MU_LOG_SHM_MAX_SITES 64 /**< Call sites listed in the control page */
+#endif
+
+#define MU_LOG_SHM_PAGE_SIZE 4096 /**< Control page size */
+#define MU_LOG_SHM_NAME_MAX 24    /**< Module and file name size, NUL included */
+#define MU_LOG_SHM_MAGIC 0x6d756c67u /**< "mulg" */
+#define MU_LOG_SHM_VERSION 2
+#define MU_LOG_SHM_NO_OVERRIDE (-1) /**< Module threshold comes from mu_log_cfg */
+
+/**
+ * @brief A module listed in the control page.
+ */
+typedef struct {
+    char name[MU_LOG_SHM_NAME_MAX];
+    volatile int32_t threshold; /**< Override, or MU_LOG_SHM_NO_OVERRIDE */
+} mu_log_shm_module_t;
+
+/**
+ * @brief A call site listed in the control page.
+ */
+typedef struct {
+    char file[MU_LOG_SHM_NAME_MAX]; /**< Source file base name */
+    uint32_t line;
+    int32_t module;            /**< Index into `modules`, or -1 */
+    volatile uint32_t enabled; /**< 0 silences the site */
+} mu_log_shm_site_t;
+
+/**
+ * @brief The control page: a page-aligned, page-sized object that
+ * `mu_log_shm_init()` maps over with shared memory.
+ *
+ * Writers change `threshold` directly; after changing a module or site entry
+ * they increment `generation` so call sites refresh their cached state.
+ * Appends to the tables take `tables_lock`, which lives in the page so that
+ * every process sharing it (a parent and its `fork()`ed children) takes the
+ * same lock.
+ */
+typedef union {
+    struct {
+        uint32_t magic;
+        uint32_t version;
+        int32_t pid;
+        volatile uint32_t threshold;  /**< Global threshold */
+        volatile uint32_t generation; /**< Bumped after any table change */
+        volatile uint32_t n_modules;
+        volatile uint32_t n_sites;
+        volatile uint32_t tables_lock; /**< Nonzero while an entry is added */
+        mu_log_shm_module_t modules[MU_LOG_SHM_MAX_MODULES];
+        mu_log_shm_site_t sites[MU_LOG_SHM_MAX_SITES];
+    };
+    unsigned char page[MU_LOG_SHM_PAGE_SIZE];
+} mu_log_shm_page_t;
+
+extern mu_log_shm_page_t mu_log_shm_page;
+
+#define MU_LOG_CURRENT_THRESHOLD ((mu_log_level_t)mu_log_shm_page.threshold)
+#else
+#define MU_LOG_CURRENT_THRESHOLD (mu_log_logger.threshold)
+#endif
+
 // *****************************************************************************
 // Public declarations
 
+#ifndef MU_LOG_STATIC_SINK
 /**
  * @brief Sets the logging function.
  * 
  * @param[in] fn Pointer to the logging function.
  */
 void mu_log_set_fn(mu_log_fn fn);
+#endif
 
 /**
  * @brief Gets the currently set logging function.
@@ -107,13 +301,16 @@ void mu_log_set_threshold(mu_log_level_t level);
 mu_log_level_t mu_log_get_threshold(void);
 
 /**
- * @brief Logs a message if its level meets or exceeds the threshold.
+ * @brief Passes a message to the logging function.
+ *
+ * Does not check the threshold: the logging macros call it only when
+ * `mu_log_will_log(level)` is true, and sinks may check again.
  * 
  * @param[in] level Log severity level.
  * @param[in] format Format string (for formatted logging) or message string.
  * @param[in] ... Optional additional parameters for formatted logging.
  */
-void mu_log(mu_log_level_t level,
+MU_LOG_COLD void mu_log(mu_log_level_t level,
   #ifdef MU_LOG_ENABLE_FORMATTED
     const char *format, ...
   #else
@@ -121,13 +318,200 @@ void mu_log(mu_log_level_t level,
   #endif
   );
 
+#if defined(MU_LOG_PRERENDER) && !defined(MU_LOG_ENABLE_FORMATTED)
+/**
+ * @brief Emits a line pre-rendered by the level macros.
+ *
+ * Writes `line` with one `fwrite()` when the sink is `mu_log_stdout_fn`, and
+ * passes `message` to any other sink.  Like `mu_log()`, does not check the
+ * threshold.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] line `"LEVEL: message\n"`, as `mu_log_stdout_fn` would print it.
+ * @param[in] len Length of `line`.
+ * @param[in] message The bare message.
+ */
+MU_LOG_COLD void mu_log_prerendered(mu_log_level_t level, const char *line,
+                                    size_t len, const char *message);
+#endif
+
 /**
  * @brief Determines if a message at the given level would be logged.
+ *
+ * Inline so that the common case -- a message below the threshold -- is a
+ * load and a compare at the call site.
  * 
  * @param[in] level Log severity level.
  * @return `true` if the message would be logged, `false` otherwise.
  */
-bool mu_log_will_log(mu_log_level_t level);
+static inline bool mu_log_will_log(mu_log_level_t level) {
+#ifdef MU_LOG_STATIC_SINK
+    return level >= MU_LOG_CURRENT_THRESHOLD;
+#else
+    return (level >= MU_LOG_CURRENT_THRESHOLD) && (mu_log_logger.log_fn != NULL);
+#endif
+}
+
+/**
+ * @struct mu_log_module_t
+ * @brief A named logging module and its cached threshold.
+ */
+typedef struct {
+    const char *name;         /**< Module name, e.g. "db.pool" */
+    unsigned generation;      /**< Table generation `threshold` came from */
+    mu_log_level_t threshold; /**< Threshold resolved from the module table */
+} mu_log_module_t;
+
+#ifdef MU_LOG_SHM
+#define mu_log_module_generation (mu_log_shm_page.generation)
+#else
+/**
+ * @brief Incremented each time the module table changes (see mu_log_cfg.h);
+ * accessed with `MU_LOG_LOAD_*()` / `MU_LOG_STORE_*()`.
+ */
+extern unsigned mu_log_module_generation;
+#endif
+
+/**
+ * @brief Looks up a module's threshold in the current module table.
+ *
+ * @param[in,out] module The module to refresh.
+ */
+void mu_log_module_resolve(mu_log_module_t *module);
+
+/**
+ * @brief Determines if a module's message at the given level would be logged.
+ *
+ * @param[in,out] module The module; its threshold is refreshed if stale.
+ * @param[in] level Log severity level.
+ * @return `true` if the message would be logged, `false` otherwise.
+ */
+static inline bool mu_log_module_will_log(mu_log_module_t *module,
+                                          mu_log_level_t level) {
+    // acquire: a current generation comes with the threshold stored before it
+    if (MU_LOG_UNLIKELY(MU_LOG_LOAD_ACQUIRE(&module->generation) !=
+                        MU_LOG_LOAD_RELAXED(&mu_log_module_generation))) {
+        mu_log_module_resolve(module);
+    }
+    return level >= MU_LOG_LOAD_RELAXED(&module->threshold) &&
+           mu_log_will_log(level);
+}
+
+#ifdef MU_LOG_MODULES
+#ifndef MU_LOG_MODULE
+#define MU_LOG_MODULE "" /**< This file's module name (default module) */
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((unused))
+#endif
+static mu_log_module_t mu_log_this_module = {MU_LOG_MODULE, 0,
+                                             MU_LOG_LEVEL_TRACE};
+#define MU_LOG_THIS_MODULE (&mu_log_this_module)
+#else
+#define MU_LOG_THIS_MODULE NULL
+#endif
+
+#if defined(MU_LOG_SHM) || defined(MU_LOG_ROUTES)
+/**
+ * @struct mu_log_site_t
+ * @brief A call site's cached state, one static instance per log statement.
+ */
+typedef struct {
+    const char *file;
+    unsigned line;
+    mu_log_module_t *module;  /**< The file's module, or NULL */
+    unsigned generation;      /**< Generation the cache is from; starts
+                                   stale, so the first call resolves it */
+#ifdef MU_LOG_SHM
+    int index;                /**< Entry in the control page; -1 until listed */
+    mu_log_level_t threshold; /**< Module threshold, or above FATAL if off */
+#endif
+#ifdef MU_LOG_ROUTES
+    unsigned char routes[MU_LOG_LEVEL_FATAL + 1]; /**< Sink mask per level */
+#endif
+} mu_log_site_t;
+
+#ifdef MU_LOG_SHM
+#define MU_LOG_SITE_SHM_INIT , -1, MU_LOG_LEVEL_TRACE
+#else
+#define MU_LOG_SITE_SHM_INIT
+#endif
+
+#define MU_LOG_SITE_INIT                                                       \
+    {__FILE__, __LINE__, MU_LOG_THIS_MODULE, ~0u MU_LOG_SITE_SHM_INIT}
+
+/**
+ * @brief Refreshes a site's cache: lists it in the control page (once, with
+ * `MU_LOG_SHM`) and recomputes its routes (with `MU_LOG_ROUTES`).
+ */
+void mu_log_site_resolve(mu_log_site_t *site);
+#endif
+
+#ifdef MU_LOG_ROUTES
+/**
+ * @brief Returns the sinks a site's record at `level` goes to.
+ *
+ * One load and one compare while the configuration is unchanged.
+ *
+ * @param[in,out] site The call site; its routes are refreshed if stale.
+ * @param[in] level Log severity level.
+ * @return Bit i set: sink i of the current configuration takes the record.
+ */
+static inline unsigned mu_log_site_routes(mu_log_site_t *site,
+                                          mu_log_level_t level) {
+    // acquire: a current generation comes with the routes stored before it
+    if (MU_LOG_UNLIKELY(MU_LOG_LOAD_ACQUIRE(&site->generation) !=
+                        MU_LOG_LOAD_RELAXED(&mu_log_module_generation))) {
+        mu_log_site_resolve(site);
+    }
+    return MU_LOG_LOAD_RELAXED(&site->routes[level]);
+}
+
+/**
+ * @brief Passes a message to the sinks in `routes` (see mu_log_cfg.h).
+ *
+ * @param[in] routes Sink mask from `mu_log_site_routes()`.
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (for formatted logging) or message string.
+ * @param[in] ... Optional additional parameters for formatted logging.
+ */
+MU_LOG_COLD void mu_log_routed(unsigned routes, mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, ...
+  #else
+    const char *message
+  #endif
+  );
+
+#define MU_LOG_SITE_WILL_LOG(level)                                           \
+    __extension__({                                                            \
+        static mu_log_site_t mu_log_site_ = MU_LOG_SITE_INIT;                  \
+        mu_log_site_routes(&mu_log_site_, level) != 0 &&                       \
+            (level) >= MU_LOG_CURRENT_THRESHOLD;                               \
+    })
+#elif defined(MU_LOG_SHM)
+static inline bool mu_log_site_will_log(mu_log_site_t *site,
+                                        mu_log_level_t level) {
+    // acquire: a current generation comes with the threshold stored before it
+    if (MU_LOG_UNLIKELY(MU_LOG_LOAD_ACQUIRE(&site->generation) !=
+                        MU_LOG_LOAD_RELAXED(&mu_log_shm_page.generation))) {
+        mu_log_site_resolve(site);
+    }
+    return level >= MU_LOG_LOAD_RELAXED(&site->threshold) &&
+           mu_log_will_log(level);
+}
+
+#define MU_LOG_SITE_WILL_LOG(level)                                           \
+    __extension__({                                                            \
+        static mu_log_site_t mu_log_site_ = MU_LOG_SITE_INIT;                  \
+        mu_log_site_will_log(&mu_log_site_, level);                            \
+    })
+#elif defined(MU_LOG_MODULES)
+#define MU_LOG_SITE_WILL_LOG(level)                                           \
+    mu_log_module_will_log(&mu_log_this_module, level)
+#else
+#define MU_LOG_SITE_WILL_LOG(level) mu_log_will_log(level)
+#endif
 
 /**
  * @brief Gets the human-readable name of a log level.
@@ -159,21 +543,94 @@ int mu_log_stdout_fn(mu_log_level_t level,
   #endif
 );
 
+#if !defined(MU_LOG_STATIC_SINK) && MU_LOG_PREINIT_SIZE > 0
+/**
+ * @brief The sink installed at startup: buffers records until a real sink is
+ * set (see `MU_LOG_PREINIT_SIZE`).
+ *
+ * Not thread-safe; meant for the single-threaded start of a program.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @param[in] ap Argument list for formatted logging.
+ * @return Number of characters buffered, or 0 if the record was dropped.
+ */
+int mu_log_preinit_fn(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+
+/**
+ * @brief Returns the number of early records that did not fit the pre-init
+ * buffer since it was last replayed.
+ */
+size_t mu_log_preinit_dropped(void);
+#endif
+
 // *****************************************************************************
 // Logging Macros
 
+#ifdef MU_LOG_STATIC_SINK
+#define MU_LOG_SET_FN(fn) ((void)(fn)) /**< Sink is bound at build time */
+#else
 #define MU_LOG_SET_FN(fn) mu_log_set_fn(fn) /**< Sets the log function */
+#endif
 #define MU_LOG_GET_FN() mu_log_get_fn() /**< Gets the log function */
 #define MU_LOG_SET_THRESHOLD(level) mu_log_set_threshold(level) /**< Sets log level */
 #define MU_LOG_GET_THRESHOLD() mu_log_get_threshold() /**< Gets log level */
-#define MU_LOG(level, ...) mu_log(level, __VA_ARGS__) /**< Logs message */
-#define MU_LOG_TRACE(...) mu_log(MU_LOG_LEVEL_TRACE, __VA_ARGS__) /**< Trace log */
-#define MU_LOG_DEBUG(...) mu_log(MU_LOG_LEVEL_DEBUG, __VA_ARGS__) /**< Debug log */
-#define MU_LOG_INFO(...)  mu_log(MU_LOG_LEVEL_INFO, __VA_ARGS__) /**< Info log */
-#define MU_LOG_WARN(...)  mu_log(MU_LOG_LEVEL_WARN, __VA_ARGS__) /**< Warning log */
-#define MU_LOG_ERROR(...) mu_log(MU_LOG_LEVEL_ERROR, __VA_ARGS__) /**< Error log */
-#define MU_LOG_FATAL(...) mu_log(MU_LOG_LEVEL_FATAL, __VA_ARGS__) /**< Fatal log */
-#define MU_LOG_WILL_LOG(level) mu_log_will_log(level) /**< Check if logging is enabled */
+#ifdef MU_LOG_ROUTES
+#define MU_LOG_ROUTED_(floor, level, ...)                                      \
+    __extension__({                                                            \
+        static mu_log_site_t mu_log_site_ = MU_LOG_SITE_INIT;                  \
+        unsigned mu_log_routes_;                                               \
+        if ((level) >= (floor) &&                                              \
+            MU_LOG_UNLIKELY((mu_log_routes_ = mu_log_site_routes(              \
+                                 &mu_log_site_, level)) != 0 &&                \
+                            (level) >= MU_LOG_CURRENT_THRESHOLD)) {            \
+            mu_log_routed(mu_log_routes_, level, __VA_ARGS__);                 \
+        }                                                                      \
+        (void)0;                                                               \
+    })
+#define MU_LOG(level, ...)                                                     \
+    MU_LOG_ROUTED_(MU_LOG_LEVEL_TRACE, level, __VA_ARGS__) /**< Logs message */
+#define MU_LOG_AT(level, ...)                                                  \
+    MU_LOG_ROUTED_(MU_LOG_COMPILE_THRESHOLD, level, __VA_ARGS__) /**< Floor-checked log */
+#else
+#define MU_LOG(level, ...)                                                     \
+    (MU_LOG_UNLIKELY(MU_LOG_SITE_WILL_LOG(level)) ? mu_log(level, __VA_ARGS__) \
+                                                  : (void)0) /**< Logs message */
+#define MU_LOG_AT(level, ...)                                                  \
+    (MU_LOG_UNLIKELY(((level) >= MU_LOG_COMPILE_THRESHOLD) &&                  \
+                     MU_LOG_SITE_WILL_LOG(level))                              \
+         ? mu_log(level, __VA_ARGS__)                                          \
+         : (void)0) /**< Floor-checked log */
+#endif
+#if defined(MU_LOG_PRERENDER) && !defined(MU_LOG_ENABLE_FORMATTED) &&         \
+    !defined(MU_LOG_ROUTES)
+#define MU_LOG_LINE_(level, name, message)                                     \
+    (MU_LOG_UNLIKELY(((level) >= MU_LOG_COMPILE_THRESHOLD) &&                  \
+                     MU_LOG_SITE_WILL_LOG(level))                              \
+         ? mu_log_prerendered(level, name ": " message "\n",                   \
+                              sizeof(name ": " message "\n") - 1, message)     \
+         : (void)0)
+#define MU_LOG_TRACE(message) MU_LOG_LINE_(MU_LOG_LEVEL_TRACE, "TRACE", message) /**< Trace log */
+#define MU_LOG_DEBUG(message) MU_LOG_LINE_(MU_LOG_LEVEL_DEBUG, "DEBUG", message) /**< Debug log */
+#define MU_LOG_INFO(message)  MU_LOG_LINE_(MU_LOG_LEVEL_INFO, "INFO", message) /**< Info log */
+#define MU_LOG_WARN(message)  MU_LOG_LINE_(MU_LOG_LEVEL_WARN, "WARN", message) /**< Warning log */
+#define MU_LOG_ERROR(message) MU_LOG_LINE_(MU_LOG_LEVEL_ERROR, "ERROR", message) /**< Error log */
+#define MU_LOG_FATAL(message) MU_LOG_LINE_(MU_LOG_LEVEL_FATAL, "FATAL", message) /**< Fatal log */
+#else
+#define MU_LOG_TRACE(...) MU_LOG_AT(MU_LOG_LEVEL_TRACE, __VA_ARGS__) /**< Trace log */
+#define MU_LOG_DEBUG(...) MU_LOG_AT(MU_LOG_LEVEL_DEBUG, __VA_ARGS__) /**< Debug log */
+#define MU_LOG_INFO(...)  MU_LOG_AT(MU_LOG_LEVEL_INFO, __VA_ARGS__) /**< Info log */
+#define MU_LOG_WARN(...)  MU_LOG_AT(MU_LOG_LEVEL_WARN, __VA_ARGS__) /**< Warning log */
+#define MU_LOG_ERROR(...) MU_LOG_AT(MU_LOG_LEVEL_ERROR, __VA_ARGS__) /**< Error log */
+#define MU_LOG_FATAL(...) MU_LOG_AT(MU_LOG_LEVEL_FATAL, __VA_ARGS__) /**< Fatal log */
+#endif
+#define MU_LOG_WILL_LOG(level) MU_LOG_SITE_WILL_LOG(level) /**< Check if logging is enabled */
 #define MU_LOG_LEVEL_NAME(level) mu_log_level_name(level) /**< Get level name */
 
 #else
@@ -184,6 +641,7 @@ int mu_log_stdout_fn(mu_log_level_t level,
 #define MU_LOG_SET_THRESHOLD(level) ((void)0)
 #define MU_LOG_GET_THRESHOLD() (0)
 #define MU_LOG(level, ...) ((void)0)
+#define MU_LOG_AT(level, ...) ((void)0)
 #define MU_LOG_TRACE(...) ((void)0)
 #define MU_LOG_DEBUG(...) ((void)0)
 #define MU_LOG_INFO(...)  ((void)0)
@@ -202,3 +660,258 @@ int mu_log_stdout_fn(mu_log_level_t level,
 #endif
 
 #endif /* _MU_LOG_H_ */
+
+// *****************************************************************************
+// Implementation
+//
+// Compiled once, by src/mu_log.c or by the one source file that defines
+// MU_LOG_IMPLEMENTATION before including this header.  Kept outside the
+// include guard so it works even if mu_log.h was already included.
+
+#if defined(MU_LOG_IMPLEMENTATION) && !defined(_MU_LOG_IMPLEMENTATION_DONE_)
+#define _MU_LOG_IMPLEMENTATION_DONE_
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole implementation
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(MU_LOG_STATIC_SINK) && MU_LOG_PREINIT_SIZE > 0
+#define MU_LOG_USE_PREINIT 1
+#endif
+
+// *****************************************************************************
+// Storage
+
+#if defined(MU_LOG_STATIC_SINK)
+mu_log_t mu_log_logger = {MU_LOG_STATIC_SINK, MU_LOG_DEFAULT_LEVEL};
+#define MU_LOG_CALL_SINK MU_LOG_STATIC_SINK
+#elif defined(MU_LOG_USE_PREINIT)
+mu_log_t mu_log_logger = {mu_log_preinit_fn, MU_LOG_DEFAULT_LEVEL};
+#define MU_LOG_CALL_SINK mu_log_logger.log_fn
+#else
+mu_log_t mu_log_logger = {NULL, MU_LOG_DEFAULT_LEVEL};
+#define MU_LOG_CALL_SINK mu_log_logger.log_fn
+#endif
+
+#ifdef MU_LOG_USE_PREINIT
+// Early records, packed as a level byte followed by NUL-terminated text
+static char s_preinit[MU_LOG_PREINIT_SIZE];
+static size_t s_preinit_used;
+static size_t s_preinit_dropped;
+
+static void preinit_replay(mu_log_fn fn);
+#endif
+
+// define s_level_names[], an array that maps a logging level to a string
+#define EXPAND_LEVEL_NAMES(_enum_id, _name) _name,
+static const char *s_level_names[] = {MU_LOG_LEVELS(EXPAND_LEVEL_NAMES)};
+#define N_LOG_LEVELS (sizeof(s_level_names)/sizeof(s_level_names[0]))
+
+// *****************************************************************************
+// Public code
+
+#ifndef MU_LOG_STATIC_SINK
+void mu_log_set_fn(mu_log_fn fn) {
+    mu_log_logger.log_fn = fn;
+#ifdef MU_LOG_USE_PREINIT
+    if (fn != NULL && fn != mu_log_preinit_fn) {
+        preinit_replay(fn);
+    }
+#endif
+}
+#endif
+
+mu_log_fn mu_log_get_fn(void) {
+    return mu_log_logger.log_fn;
+}
+
+void mu_log_set_threshold(mu_log_level_t threshold) {
+#ifdef MU_LOG_SHM
+    mu_log_shm_page.threshold = (uint32_t)threshold;
+#else
+    mu_log_logger.threshold = threshold;
+#endif
+}
+
+mu_log_level_t mu_log_get_threshold(void) {
+    return MU_LOG_CURRENT_THRESHOLD;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+// using formatted logging
+void mu_log(mu_log_level_t level, const char *format, ...) {
+    va_list ap;
+#ifndef MU_LOG_STATIC_SINK
+    if (mu_log_logger.log_fn == NULL) {
+        return;
+    }
+#endif
+    va_start(ap, format);
+    MU_LOG_CALL_SINK(level, format, ap);
+    va_end(ap);
+}
+
+#else
+// using simple string logging
+void mu_log(mu_log_level_t level, const char *message) {
+#ifndef MU_LOG_STATIC_SINK
+    if (mu_log_logger.log_fn == NULL) {
+        return;
+    }
+#endif
+    MU_LOG_CALL_SINK(level, message);
+}
+#endif
+
+#if defined(MU_LOG_PRERENDER) && !defined(MU_LOG_ENABLE_FORMATTED)
+void mu_log_prerendered(mu_log_level_t level, const char *line, size_t len,
+                        const char *message) {
+    mu_log_fn fn = MU_LOG_CALL_SINK;
+
+    if (fn == mu_log_stdout_fn) {
+        // one call, one stream lock, no strlen()
+        fwrite(line, 1, len, stdout);
+    } else if (fn != NULL) {
+        fn(level, message);
+    }
+}
+#endif
+
+const char *mu_log_level_name(mu_log_level_t level) {
+    if (level < N_LOG_LEVELS) {
+        return s_level_names[level];
+    } else {
+        return "UNKNOWN";
+    }
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_stdout_fn(mu_log_level_t level, const char *format, va_list ap) {
+    int n1, n2, n3;
+
+    if (!mu_log_will_log(level)) {
+        return 0;
+    }
+
+    n1 = printf("%5s: ", mu_log_level_name(level));
+    if (n1 < 0) return n1;
+
+    n2 = vprintf(format, ap);
+    if (n2 < 0) return n2;
+
+    n3 = printf("\n");
+    if (n3 < 0) return n3;
+
+    return n1 + n2 + n3;
+}
+
+#else
+int mu_log_stdout_fn(mu_log_level_t level, const char *message) {
+    int n;
+
+    if (!mu_log_will_log(level)) {
+        return 0;
+    }
+    n = fputs(mu_log_level_name(level), stdout);
+    if (n < 0) return n;
+
+    n = fputs(": ", stdout);
+    if (n < 0) return n;
+
+    n = fputs(message, stdout);
+    if (n < 0) return n;
+
+    n = fputs("\n", stdout);
+    if (n < 0) return n;
+
+    return n;
+}
+#endif
+
+#ifdef MU_LOG_USE_PREINIT
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_preinit_fn(mu_log_level_t level, const char *format, va_list ap) {
+    size_t avail = sizeof(s_preinit) - s_preinit_used;
+    int n;
+
+    if (!mu_log_will_log(level)) {
+        return 0;
+    }
+    // render now: the arguments do not outlive this call
+    n = avail > 1 ? vsnprintf(&s_preinit[s_preinit_used + 1], avail - 1,
+                              format, ap)
+                  : -1;
+    if (n < 0 || (size_t)n + 2 > avail) {
+        s_preinit_dropped++;
+        return 0;
+    }
+    s_preinit[s_preinit_used] = (char)level;
+    s_preinit_used += (size_t)n + 2;
+    return n;
+}
+
+static void preinit_emit(mu_log_fn fn, mu_log_level_t level,
+                         const char *format, ...) {
+    va_list ap;
+    va_start(ap, format);
+    fn(level, format, ap);
+    va_end(ap);
+}
+
+#else
+int mu_log_preinit_fn(mu_log_level_t level, const char *message) {
+    size_t len = strlen(message);
+
+    if (!mu_log_will_log(level)) {
+        return 0;
+    }
+    if (len + 2 > sizeof(s_preinit) - s_preinit_used) {
+        s_preinit_dropped++;
+        return 0;
+    }
+    s_preinit[s_preinit_used] = (char)level;
+    memcpy(&s_preinit[s_preinit_used + 1], message, len + 1);
+    s_preinit_used += len + 2;
+    return (int)len;
+}
+#endif
+
+size_t mu_log_preinit_dropped(void) {
+    return s_preinit_dropped;
+}
+
+static void preinit_replay(mu_log_fn fn) {
+    size_t pos = 0;
+
+    while (pos < s_preinit_used) {
+        mu_log_level_t level = (mu_log_level_t)s_preinit[pos];
+        const char *text = &s_preinit[pos + 1];
+#ifdef MU_LOG_ENABLE_FORMATTED
+        preinit_emit(fn, level, "%s", text);
+#else
+        fn(level, text);
+#endif
+        pos += strlen(text) + 2;
+    }
+    if (s_preinit_dropped != 0) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+        preinit_emit(fn, MU_LOG_LEVEL_WARN,
+                     "mu_log: %u early records dropped",
+                     (unsigned)s_preinit_dropped);
+#else
+        char line[48];
+        snprintf(line, sizeof(line), "mu_log: %u early records dropped",
+                 (unsigned)s_preinit_dropped);
+        fn(MU_LOG_LEVEL_WARN, line);
+#endif
+    }
+    s_preinit_used = 0;
+    s_preinit_dropped = 0;
+}
+#endif
+
+#endif /* MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+#endif /* MU_LOG_IMPLEMENTATION */
@@ -0,0 +1,513 @@
+/**
+ * @file mu_log.hpp
+ * @brief Header-only C++ layer: logging pipelines composed at compile time.
+ *
+ * A pipeline is a list of stage types, run in order for every record:
+ *
+ * ```cpp
+ * using app_log = mu::pipeline<mu::rate_limit<1000>,
+ *                              mu::level_filter<MU_LOG_LEVEL_INFO>,
+ *                              mu::json_format,
+ *                              mu::file_sink>;
+ * app_log log;
+ * log.info("request {} took {} us", id, elapsed);
+ * ```
+ *
+ * Each stage is a plain class; its role is recognised from the member it has:
+ *
+ * - filter:    `bool accept(mu_log_level_t level)` -- all filters must accept
+ * - formatter: `size_t format(char *buf, size_t size, mu_log_level_t level,
+ *               const char *msg, size_t len)` -- at most one; it builds the
+ *               line, and without one the line is the message itself
+ * - sink:      `void write(mu_log_level_t level, const char *line,
+ *               size_t len)` -- every sink receives the line
+ *
+ * Stages are held by value and called directly, so the whole path inlines:
+ * no function pointers and no `va_list`.  Messages use `{}` placeholders,
+ * filled from integers, floating point, `bool`, `char`, strings and pointers
+ * into a fixed stack buffer (`MU_LOG_CPP_LINE_MAX`), with no allocation.
+ *
+ * `mu::install<P>()` registers a process-wide `P` instance as the regular
+ * `mu_log_fn`, so C code calling `MU_LOG_INFO()` routes into the same
+ * pipeline.  In formatted mode the C format string is rendered with
+ * `vsnprintf()` first.  Every thread that logs then shares that one instance,
+ * so a stage with state of its own must be thread-safe (`rate_limit` locks
+ * its bucket).  Requires C++17.
+ */
+
+#ifndef _MU_LOG_HPP_
+#define _MU_LOG_HPP_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_CPP_LINE_MAX
+#define MU_LOG_CPP_LINE_MAX 256 /**< Message and line buffer size, in bytes */
+#endif
+
+namespace mu {
+
+// *****************************************************************************
+// Message rendering
+
+/**
+ * @brief Bounded output buffer; writes past the end are counted, not stored.
+ */
+class writer {
+public:
+    writer(char *buf, size_t size) : buf_(buf), size_(size), len_(0) {}
+
+    void put(char ch) {
+        if (len_ + 1 < size_) {
+            buf_[len_] = ch;
+        }
+        len_++;
+    }
+
+    void put(const char *s, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            put(s[i]);
+        }
+    }
+
+    void put(const char *s) { put(s, std::strlen(s)); }
+
+    /** Returns the length written so far, stored or not. */
+    size_t length() const { return len_; }
+
+    /** NUL-terminates and returns the stored length. */
+    size_t finish() {
+        size_t n = len_ < size_ ? len_ : (size_ ? size_ - 1 : 0);
+        if (size_) {
+            buf_[n] = '\0';
+        }
+        return n;
+    }
+
+private:
+    char *buf_;
+    size_t size_;
+    size_t len_;
+};
+
+namespace detail {
+
+inline void put_unsigned(writer &w, unsigned long long v, unsigned base) {
+    char digits[24];
+    int n = 0;
+    do {
+        digits[n++] = "0123456789abcdef"[v % base];
+        v /= base;
+    } while (v != 0);
+    while (n > 0) {
+        w.put(digits[--n]);
+    }
+}
+
+inline void put_arg(writer &w, bool v) { w.put(v ? "true" : "false"); }
+inline void put_arg(writer &w, char v) { w.put(v); }
+inline void put_arg(writer &w, const char *v) { w.put(v ? v : "(null)"); }
+inline void put_arg(writer &w, char *v) { put_arg(w, (const char *)v); }
+
+inline void put_arg(writer &w, const void *v) {
+    w.put("0x");
+    put_unsigned(w, (unsigned long long)(uintptr_t)v, 16);
+}
+
+inline void put_arg(writer &w, double v) {
+    char tmp[32];
+    int n = std::snprintf(tmp, sizeof(tmp), "%g", v);
+    w.put(tmp, n > 0 ? (size_t)n : 0);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value>::type put_arg(writer &w,
+                                                                  T v) {
+    if (std::is_signed<T>::value && v < 0) {
+        w.put('-');
+        put_unsigned(w, 0ull - (unsigned long long)v, 10);
+    } else {
+        put_unsigned(w, (unsigned long long)v, 10);
+    }
+}
+
+template <class T>
+typename std::enable_if<std::is_enum<T>::value>::type put_arg(writer &w, T v) {
+    put_arg(w, (long long)v);
+}
+
+inline void put_arg(writer &w, float v) { put_arg(w, (double)v); }
+
+template <class T> void put_arg(writer &w, T *v) {
+    put_arg(w, (const void *)v);
+}
+
+/** Copies `fmt` up to the next `{}` (or the end); `{{` and `}}` escape. */
+inline const char *put_until_placeholder(writer &w, const char *fmt) {
+    while (*fmt) {
+        if (fmt[0] == '{' && fmt[1] == '}') {
+            return fmt;
+        }
+        if ((fmt[0] == '{' && fmt[1] == '{') || (fmt[0] == '}' && fmt[1] == '}')) {
+            fmt++;
+        }
+        w.put(*fmt++);
+    }
+    return fmt;
+}
+
+inline void format_args(writer &w, const char *fmt) {
+    put_until_placeholder(w, fmt);
+}
+
+template <class T, class... Rest>
+void format_args(writer &w, const char *fmt, const T &arg, const Rest &...rest) {
+    fmt = put_until_placeholder(w, fmt);
+    if (*fmt == '\0') {
+        return; // more arguments than placeholders
+    }
+    put_arg(w, arg);
+    format_args(w, fmt + 2, rest...);
+}
+
+// Stage role detection
+template <class S, class = void> struct is_filter : std::false_type {};
+template <class S>
+struct is_filter<S, decltype((void)std::declval<S &>().accept(
+                        MU_LOG_LEVEL_INFO))> : std::true_type {};
+
+template <class S, class = void> struct is_formatter : std::false_type {};
+template <class S>
+struct is_formatter<S, decltype((void)std::declval<S &>().format(
+                           (char *)0, size_t(0), MU_LOG_LEVEL_INFO,
+                           (const char *)0, size_t(0)))> : std::true_type {};
+
+template <class S, class = void> struct is_sink : std::false_type {};
+template <class S>
+struct is_sink<S, decltype((void)std::declval<S &>().write(
+                      MU_LOG_LEVEL_INFO, (const char *)0, size_t(0)))>
+    : std::true_type {};
+
+template <class... S> struct count_formatters;
+template <> struct count_formatters<> : std::integral_constant<int, 0> {};
+template <class S, class... R>
+struct count_formatters<S, R...>
+    : std::integral_constant<int, is_formatter<S>::value +
+                                      count_formatters<R...>::value> {};
+
+} // namespace detail
+
+/**
+ * @brief Renders `fmt` with `{}` placeholders into `buf`.
+ *
+ * @return The stored length (excluding the NUL); output is truncated to fit.
+ */
+template <class... Args>
+size_t format_to(char *buf, size_t size, const char *fmt, const Args &...args) {
+    writer w(buf, size);
+    detail::format_args(w, fmt, args...);
+    return w.finish();
+}
+
+// *****************************************************************************
+// Stages
+
+/**
+ * @brief Filter: passes records at or above `Level`.
+ */
+template <mu_log_level_t Level> struct level_filter {
+    bool accept(mu_log_level_t level) const { return level >= Level; }
+};
+
+/**
+ * @brief Filter: token bucket allowing `PerSecond` records per second, with
+ * bursts up to `PerSecond`.  Rejected records are counted in `dropped`.  The
+ * bucket is locked per instance, so one installed limiter can be shared.
+ */
+template <unsigned PerSecond> class rate_limit {
+public:
+    bool accept(mu_log_level_t) {
+        using namespace std::chrono;
+        int64_t now = duration_cast<nanoseconds>(
+                          steady_clock::now().time_since_epoch())
+                          .count();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (last_ns_ == 0) {
+            last_ns_ = now;
+        }
+        tokens_ += (double)(now - last_ns_) * PerSecond / 1e9;
+        if (tokens_ > PerSecond) {
+            tokens_ = PerSecond;
+        }
+        last_ns_ = now;
+        if (tokens_ < 1.0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        tokens_ -= 1.0;
+        return true;
+    }
+
+    std::atomic<size_t> dropped{0};
+
+private:
+    std::mutex mutex_;
+    double tokens_ = PerSecond;
+    int64_t last_ns_ = 0;
+};
+
+/**
+ * @brief Formatter: `LEVEL: message`, as written by `mu_log_stdout_fn`.
+ */
+struct text_format {
+    size_t format(char *buf, size_t size, mu_log_level_t level,
+                  const char *msg, size_t len) const {
+        writer w(buf, size);
+        w.put(mu_log_level_name(level));
+        w.put(": ");
+        w.put(msg, len);
+        return w.finish();
+    }
+};
+
+/**
+ * @brief Formatter: one JSON object, `{"level":"INFO","msg":"..."}`.
+ *
+ * A message too long for the line is cut before the first escape that would
+ * not fit whole with the closing `"}`, so the line stays valid JSON.
+ */
+struct json_format {
+    size_t format(char *buf, size_t size, mu_log_level_t level,
+                  const char *msg, size_t len) const {
+        writer w(buf, size);
+        w.put("{\"level\":\"");
+        w.put(mu_log_level_name(level));
+        w.put("\",\"msg\":\"");
+        for (size_t i = 0; i < len; i++) {
+            char esc[6];
+            size_t n = escape((unsigned char)msg[i], esc);
+            if (w.length() + n + 2 >= size) { // keep `"}` and the NUL
+                break;
+            }
+            w.put(esc, n);
+        }
+        w.put("\"}");
+        return w.finish();
+    }
+
+private:
+    static size_t escape(unsigned char ch, char *esc) {
+        if (ch == '"' || ch == '\\') {
+            esc[0] = '\\';
+            esc[1] = (char)ch;
+            return 2;
+        }
+        if (ch == '\n') {
+            esc[0] = '\\';
+            esc[1] = 'n';
+            return 2;
+        }
+        if (ch < 0x20) {
+            std::memcpy(esc, "\\u00", 4);
+            esc[4] = "0123456789abcdef"[ch >> 4];
+            esc[5] = "0123456789abcdef"[ch & 0xf];
+            return 6;
+        }
+        esc[0] = (char)ch;
+        return 1;
+    }
+};
+
+/**
+ * @brief Sink: writes each line and a newline to a `FILE *` (default
+ * stdout).  Set `file` to redirect, e.g. `log.get<mu::file_sink>().file = f`.
+ */
+struct file_sink {
+    void write(mu_log_level_t, const char *line, size_t len) {
+        std::fwrite(line, 1, len, file);
+        std::fputc('\n', file);
+    }
+
+    std::FILE *file = stdout;
+};
+
+// *****************************************************************************
+// Pipeline
+
+/**
+ * @brief A logging pipeline of filters, at most one formatter, and sinks.
+ */
+template <class... Stages> class pipeline {
+    static_assert(detail::count_formatters<Stages...>::value <= 1,
+                  "a pipeline takes at most one formatter");
+
+public:
+    /** Returns the stage of type `S`, e.g. to configure it. */
+    template <class S> S &get() { return std::get<S>(stages_); }
+
+    /** Returns true if every filter accepts `level`. */
+    bool will_log(mu_log_level_t level) {
+        return std::apply(
+            [level](auto &...s) { return (accept(s, level) && ...); },
+            stages_);
+    }
+
+    /** Logs `fmt`, filling `{}` placeholders from `args`. */
+    template <class... Args>
+    void log(mu_log_level_t level, const char *fmt, const Args &...args) {
+        if (!will_log(level)) {
+            return;
+        }
+        char msg[MU_LOG_CPP_LINE_MAX];
+        size_t len = format_to(msg, sizeof(msg), fmt, args...);
+        emit(level, msg, len);
+    }
+
+    /** Formats and writes an already-rendered message (filters not applied). */
+    void emit(mu_log_level_t level, const char *msg, size_t len) {
+        if constexpr (detail::count_formatters<Stages...>::value == 0) {
+            write_all(level, msg, len);
+        } else {
+            char line[MU_LOG_CPP_LINE_MAX];
+            size_t n = 0;
+            std::apply(
+                [&](auto &...s) {
+                    (format_one(s, line, sizeof(line), level, msg, len, n),
+                     ...);
+                },
+                stages_);
+            write_all(level, line, n);
+        }
+    }
+
+    template <class... Args> void trace(const char *fmt, const Args &...a) {
+        log(MU_LOG_LEVEL_TRACE, fmt, a...);
+    }
+    template <class... Args> void debug(const char *fmt, const Args &...a) {
+        log(MU_LOG_LEVEL_DEBUG, fmt, a...);
+    }
+    template <class... Args> void info(const char *fmt, const Args &...a) {
+        log(MU_LOG_LEVEL_INFO, fmt, a...);
+    }
+    template <class... Args> void warn(const char *fmt, const Args &...a) {
+        log(MU_LOG_LEVEL_WARN, fmt, a...);
+    }
+    template <class... Args> void error(const char *fmt, const Args &...a) {
+        log(MU_LOG_LEVEL_ERROR, fmt, a...);
+    }
+    template <class... Args> void fatal(const char *fmt, const Args &...a) {
+        log(MU_LOG_LEVEL_FATAL, fmt, a...);
+    }
+
+private:
+    template <class S> static bool accept(S &s, mu_log_level_t level) {
+        if constexpr (detail::is_filter<S>::value) {
+            return s.accept(level);
+        } else {
+            return true;
+        }
+    }
+
+    template <class S>
+    static void format_one(S &s, char *line, size_t size, mu_log_level_t level,
+                           const char *msg, size_t len, size_t &n) {
+        if constexpr (detail::is_formatter<S>::value) {
+            n = s.format(line, size, level, msg, len);
+        }
+    }
+
+    void write_all(mu_log_level_t level, const char *line, size_t len) {
+        std::apply(
+            [&](auto &...s) { (write_one(s, level, line, len), ...); },
+            stages_);
+    }
+
+    template <class S>
+    static void write_one(S &s, mu_log_level_t level, const char *line,
+                          size_t len) {
+        if constexpr (detail::is_sink<S>::value) {
+            s.write(level, line, len);
+        }
+    }
+
+    std::tuple<Stages...> stages_;
+};
+
+// *****************************************************************************
+// Bridge from the C API
+
+/**
+ * @brief The process-wide instance of pipeline `P` used by `install<P>()`.
+ */
+template <class P> P &instance() {
+    static P p;
+    return p;
+}
+
+namespace detail {
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+template <class P>
+int c_sink(mu_log_level_t level, const char *format, va_list ap) {
+    P &p = instance<P>();
+    if (!p.will_log(level)) {
+        return 0;
+    }
+    char msg[MU_LOG_CPP_LINE_MAX];
+    int n = std::vsnprintf(msg, sizeof(msg), format, ap);
+    size_t len = n < 0 ? 0 : ((size_t)n < sizeof(msg) ? (size_t)n
+                                                       : sizeof(msg) - 1);
+    p.emit(level, msg, len);
+    return (int)len;
+}
+#else
+template <class P> int c_sink(mu_log_level_t level, const char *message) {
+    P &p = instance<P>();
+    if (!p.will_log(level)) {
+        return 0;
+    }
+    size_t len = std::strlen(message);
+    p.emit(level, message, len);
+    return (int)len;
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Routes C logging (`MU_LOG_*()`) into `instance<P>()`.
+ *
+ * The C threshold still applies before the pipeline's own filters; lower it
+ * (e.g. to `MU_LOG_LEVEL_TRACE`) to let the pipeline decide alone.  Not
+ * available when the sink is bound with `MU_LOG_STATIC_SINK`.
+ */
+#ifndef MU_LOG_STATIC_SINK
+template <class P> void install() { mu_log_set_fn(&detail::c_sink<P>); }
+#endif
+
+} // namespace mu
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#endif /* _MU_LOG_HPP_ */
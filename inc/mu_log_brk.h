@@ -0,0 +1,119 @@
+/**
+ * @file mu_log_brk.h
+ * @brief Circuit breaker around a sink that may stall.
+ *
+ * A sink writing to a pipe can block for as long as the reader does, and
+ * every logging thread blocks with it.  `mu_log_brk_fn` wraps the real sink
+ * and times each call.  A call that fails (returns a negative value, e.g. a
+ * non-blocking stdout reporting `EAGAIN`) or takes longer than the slow
+ * limit trips the breaker: records then go into the mu_log_buf ring (see
+ * mu_log_buf.h), which counts the ones it cannot hold.  Once per probe
+ * interval a record replays the backlog into the sink.  If every call is
+ * quick, the breaker closes again:
+ *
+ * ```c
+ * setvbuf(stdout, NULL, _IOLBF, 0);
+ * fcntl(STDOUT_FILENO, F_SETFL, O_NONBLOCK);  // fail rather than block
+ * mu_log_buf_init(8192);
+ * mu_log_brk_init(mu_log_stdout_fn, 5000000, 1000000000);  // 5 ms, 1 s
+ * MU_LOG_SET_FN(mu_log_brk_fn);
+ * ```
+ *
+ * Tripping and recovering are logged through the same path, as
+ * `mu_log_brk: sink stalled ...` (WARN, first record in the backlog) and
+ * `mu_log_brk: sink recovered ...` (INFO, after the backlog).  A call that
+ * blocks indefinitely is only seen when it returns; a non-blocking sink
+ * turns that into a failure.
+ */
+
+#ifndef _MU_LOG_BRK_H_
+#define _MU_LOG_BRK_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_buf.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief Breaker state.
+ */
+typedef enum {
+    MU_LOG_BRK_CLOSED, /**< Records go to the sink */
+    MU_LOG_BRK_OPEN,   /**< Records go to the ring until a probe succeeds */
+} mu_log_brk_state_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Sets the wrapped sink and the limits, and closes the breaker.
+ *
+ * Call after `mu_log_buf_init()` and before logging starts.
+ *
+ * @param[in] sink The sink to protect.
+ * @param[in] slow_ns A call taking longer than this trips the breaker.
+ * @param[in] probe_ns Time between recovery attempts while open.
+ */
+void mu_log_brk_init(mu_log_fn sink, uint64_t slow_ns, uint64_t probe_ns);
+
+/**
+ * @brief Sets the clock used to time sink calls.
+ *
+ * @param[in] clock Clock returning nanoseconds, or NULL for
+ *            `CLOCK_MONOTONIC` (the default).
+ */
+void mu_log_brk_set_clock(mu_log_clock_fn clock);
+
+/**
+ * @brief Returns the breaker state.
+ */
+mu_log_brk_state_t mu_log_brk_state(void);
+
+/**
+ * @brief Returns how many times the breaker has tripped since init.
+ */
+size_t mu_log_brk_trips(void);
+
+/**
+ * @brief A logging function that passes records to the wrapped sink while
+ * the breaker is closed, and to the ring while it is open.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @param[in] ap Argument list for formatted logging.
+ * @return The sink's return value, or the number of characters buffered.
+ */
+int mu_log_brk_fn(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_BRK_H_ */
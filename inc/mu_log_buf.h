@@ -0,0 +1,224 @@
+/**
+ * @file mu_log_buf.h
+ * @brief Buffered logging with zero-copy reserve/commit.
+ *
+ * Records are written into a lock-free multi-producer ring of variable-length
+ * records and emitted later, by `mu_log_buf_drain()`, from a single consumer
+ * (a logging thread or the idle loop).  Producers never format into a stack
+ * buffer and copy: `mu_log_reserve()` returns a writable span inside the
+ * ring, the caller formats straight into it, and `mu_log_commit()` publishes
+ * it with the length actually used:
+ *
+ * ```c
+ * mu_log_span_t span = mu_log_reserve(MU_LOG_LEVEL_INFO, 64);
+ * if (span.data != NULL) {
+ *     size_t n = render_state(span.data, span.size);  // writes once
+ *     mu_log_commit(span, n);
+ * }
+ * ```
+ *
+ * Installed as the sink (`MU_LOG_SET_FN(mu_log_buf_fn)`), the ordinary
+ * `MU_LOG_*()` macros do the same: in formatted mode the sink reserves
+ * `MU_LOG_BUF_LINE_MAX` bytes and `vsnprintf()`s directly into the span.
+ *
+ * A reserved record occupies its full reserved size until drained, and the
+ * drain stops at the oldest record that has been reserved but not yet
+ * committed, so keep the reserve/commit window short.  When the ring is full
+ * the record is dropped and counted.
+ *
+ * `mu_log_batch_begin()` / `mu_log_batch_append()` / `mu_log_batch_end()`
+ * group several lines (a table, a state dump) into a single record, so they
+ * are drained contiguously, with no other thread's lines in between, and
+ * reach the writer as one write.
+ */
+
+#ifndef _MU_LOG_BUF_H_
+#define _MU_LOG_BUF_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_BUF_LINE_MAX
+#define MU_LOG_BUF_LINE_MAX 128 /**< Bytes reserved per line by mu_log_buf_fn */
+#endif
+
+#ifndef MU_LOG_BUF_BATCH_MAX
+#define MU_LOG_BUF_BATCH_MAX 512 /**< Bytes reserved per batch */
+#endif
+
+#ifndef MU_LOG_BUF_THREAD_LOCAL
+/** Storage class of the open batch; define empty on single-threaded targets
+ *  without TLS support. */
+#define MU_LOG_BUF_THREAD_LOCAL _Thread_local
+#endif
+
+/**
+ * @struct mu_log_span_t
+ * @brief A writable region inside the ring, returned by `mu_log_reserve()`.
+ */
+typedef struct {
+    char *data;   /**< Where to write; NULL if nothing was reserved */
+    size_t size;  /**< Bytes available at `data` */
+    void *record; /**< Internal: the record header */
+} mu_log_span_t;
+
+/**
+ * @brief Receives one drained record.
+ *
+ * @param[in] level Level the record was reserved with.
+ * @param[in] data Record text (not NUL-terminated).
+ * @param[in] len Length of `data`.
+ * @param[in] arg User argument given to `mu_log_buf_drain()`.
+ */
+typedef void (*mu_log_buf_writer_fn)(mu_log_level_t level, const char *data,
+                                     size_t len, void *arg);
+
+/**
+ * @brief Returns the current time, in units of the application's choosing,
+ * for batch headers.
+ */
+typedef uint64_t (*mu_log_clock_fn)(void);
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Allocates the ring (through `mu_log_alloc()`) and empties it.
+ *
+ * Call once, before logging starts.
+ *
+ * @param[in] size Ring size in bytes; a power of two, at least 64.
+ * @return `true` on success, `false` if the size is invalid or allocation
+ *         failed.
+ */
+bool mu_log_buf_init(size_t size);
+
+/**
+ * @brief Reserves up to `max_len` bytes for one record.
+ *
+ * Safe to call from any number of threads.
+ *
+ * @param[in] level Log severity level; below the threshold nothing is
+ *            reserved.
+ * @param[in] max_len Bytes to reserve (at most a quarter of the ring).
+ * @return A span, with `data == NULL` if filtered or the ring is full.
+ */
+mu_log_span_t mu_log_reserve(mu_log_level_t level, size_t max_len);
+
+/**
+ * @brief Publishes a reserved span.
+ *
+ * @param[in] span The span from `mu_log_reserve()`; ignored if empty.
+ * @param[in] used_len Bytes written (clamped to `span.size`).
+ */
+void mu_log_commit(mu_log_span_t span, size_t used_len);
+
+/**
+ * @brief Hands committed records, oldest first, to `write`.
+ *
+ * Single consumer: call from one thread only.
+ *
+ * @param[in] write Writer for each record.
+ * @param[in] arg User argument passed to `write`.
+ * @param[in] max_records Maximum records to drain, or 0 for all available.
+ * @return Number of records passed to `write`.
+ */
+size_t mu_log_buf_drain(mu_log_buf_writer_fn write, void *arg,
+                        size_t max_records);
+
+/**
+ * @brief Returns the number of records dropped because the ring was full.
+ */
+size_t mu_log_buf_dropped(void);
+
+/**
+ * @brief A logging function that writes each line into the ring.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @param[in] ap Argument list for formatted logging.
+ * @return Number of characters buffered.
+ */
+int mu_log_buf_fn(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+
+/**
+ * @brief A drain writer producing `mu_log_stdout_fn`'s `LEVEL: message` lines
+ * on stdout.
+ */
+void mu_log_buf_stdout_writer(mu_log_level_t level, const char *data,
+                              size_t len, void *arg);
+
+/**
+ * @brief Sets the clock read once per batch for its header.
+ *
+ * @param[in] clock Clock function, or NULL (the default) for timestamp 0.
+ */
+void mu_log_batch_set_clock(mu_log_clock_fn clock);
+
+/**
+ * @brief Opens a batch on the calling thread.
+ *
+ * Reserves `MU_LOG_BUF_BATCH_MAX` bytes (at most a quarter of the ring) and
+ * writes the header line `batch @<timestamp>`.  Each thread may have one
+ * batch open at a time.
+ *
+ * @param[in] level Log severity level of the whole batch.
+ * @return `true` if the batch was opened; `false` if the level is filtered,
+ *         the ring is full or a batch is already open.  Appends to a batch
+ *         that was not opened are discarded.
+ */
+bool mu_log_batch_begin(mu_log_level_t level);
+
+/**
+ * @brief Appends one line to the open batch.
+ *
+ * A line that does not fit in the remaining space is discarded whole.
+ *
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @return `true` if the line was added.
+ */
+#ifdef MU_LOG_ENABLE_FORMATTED
+bool mu_log_batch_append(const char *format, ...);
+#else
+bool mu_log_batch_append(const char *message);
+#endif
+
+/**
+ * @brief Closes the open batch and commits it as a single record.
+ */
+void mu_log_batch_end(void);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_BUF_H_ */
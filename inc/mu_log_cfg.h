@@ -0,0 +1,251 @@
+/**
+ * @file mu_log_cfg.h
+ * @brief Lock-free runtime reconfiguration through immutable snapshots.
+ *
+ * The configuration -- the sinks, a threshold per sink and the module
+ * threshold table -- lives in an
+ * immutable `mu_log_config_t` snapshot.  `mu_log_cfg_publish()` copies a new
+ * configuration into a free snapshot and swaps the current-snapshot pointer;
+ * the logging path (`mu_log_cfg_fn`, installed as the sink) only loads that
+ * pointer, so it never takes a lock and never writes a shared cache line.
+ *
+ * Old snapshots are reclaimed by quiescent-state-based reclamation (QSBR).
+ * Every thread that logs while another thread may publish registers as a
+ * reader and, from time to time, when it is not in the middle of a log call
+ * (e.g. once per main-loop iteration), reports a quiescent state.  A retired
+ * snapshot is reused once every registered reader has reported a quiescent
+ * state since it was retired:
+ *
+ * ```c
+ * int reader = mu_log_cfg_register_reader();
+ * for (;;) {
+ *     handle_request();            // logs freely
+ *     mu_log_cfg_quiescent(reader);
+ * }
+ * ```
+ *
+ * Single-threaded programs need not register.  Snapshots come from a fixed
+ * pool of `MU_LOG_CFG_SNAPSHOTS`, taken from `mu_log_alloc()` by
+ * `mu_log_cfg_init()`; publish fails if every spare snapshot is still waiting
+ * for a reader's quiescent state.
+ */
+
+#ifndef _MU_LOG_CFG_H_
+#define _MU_LOG_CFG_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_CFG_MAX_SINKS
+#define MU_LOG_CFG_MAX_SINKS 4 /**< Sinks per configuration */
+#endif
+
+#ifndef MU_LOG_CFG_SNAPSHOTS
+#define MU_LOG_CFG_SNAPSHOTS 4 /**< Snapshots in the pool (current + spares) */
+#endif
+
+#ifndef MU_LOG_CFG_MAX_MODULES
+#define MU_LOG_CFG_MAX_MODULES 8 /**< Module rules per configuration */
+#endif
+
+#ifndef MU_LOG_CFG_MODULE_NAME_MAX
+#define MU_LOG_CFG_MODULE_NAME_MAX 16 /**< Module name size, NUL included */
+#endif
+
+#ifndef MU_LOG_CFG_MAX_READERS
+#define MU_LOG_CFG_MAX_READERS 8 /**< Registered reader threads */
+#endif
+
+/**
+ * @struct mu_log_cfg_sink_t
+ * @brief One sink, the minimum level it receives and, optionally, the
+ * modules it receives.
+ *
+ * `module` is matched like a module rule: "net" takes "net" and "net.tcp".
+ * An empty name takes every module.
+ */
+typedef struct {
+    mu_log_fn fn;             /**< Logging function */
+    mu_log_level_t threshold; /**< Minimum severity level for this sink */
+    char module[MU_LOG_CFG_MODULE_NAME_MAX]; /**< Module prefix; "": all */
+} mu_log_cfg_sink_t;
+
+/**
+ * @struct mu_log_cfg_module_t
+ * @brief The threshold for one module and the modules below it.
+ *
+ * The rule named "db" applies to modules "db" and "db.pool" (a dot-separated
+ * prefix); the longest matching rule wins.
+ */
+typedef struct {
+    char name[MU_LOG_CFG_MODULE_NAME_MAX]; /**< Module name or prefix */
+    mu_log_level_t threshold;              /**< Minimum severity level */
+    uint64_t expires; /**< `mu_log_spec` clock time to drop the rule; 0: never */
+} mu_log_cfg_module_t;
+
+/**
+ * @struct mu_log_config_t
+ * @brief A complete logging configuration.
+ *
+ * A zero-initialized configuration has no sinks and lets every module log at
+ * every level.
+ */
+typedef struct {
+    size_t n_sinks;                                /**< Sinks in use */
+    mu_log_cfg_sink_t sinks[MU_LOG_CFG_MAX_SINKS]; /**< The sinks */
+    mu_log_level_t module_default; /**< Threshold where no rule matches */
+    size_t n_modules;              /**< Module rules in use */
+    mu_log_cfg_module_t modules[MU_LOG_CFG_MAX_MODULES]; /**< The rules */
+} mu_log_config_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Allocates the snapshot pool and reader table and publishes an empty
+ * configuration.
+ *
+ * Call once, before logging starts.  Installs no sink and leaves the global
+ * threshold as it is, so a program that only uses `mu_log_spec_*()` or
+ * `mu_log_stdout_fn` keeps logging as before.
+ *
+ * @return `true` on success, `false` if allocation failed.
+ */
+bool mu_log_cfg_init(void);
+
+/**
+ * @brief Publishes a copy of `config` as the current configuration.
+ *
+ * Also sets the global threshold (`mu_log_set_threshold()`) to the lowest
+ * level any sink and any module can receive, so the inline check still
+ * filters before `mu_log()`, and makes `MU_LOG_MODULES` call sites look up
+ * their thresholds again.  A configuration with no sinks leaves the global
+ * threshold unchanged.
+ * Publishers are serialized with each other, never with readers.
+ *
+ * @param[in] config The new configuration; copied, so it may be reused.
+ * @return `true` on success, `false` if `config` has too many sinks or
+ *         modules, or no
+ *         snapshot is free (readers have not yet been quiescent).
+ */
+bool mu_log_cfg_publish(const mu_log_config_t *config);
+
+/**
+ * @brief Returns the threshold the module table gives a module name.
+ *
+ * @param[in] config The configuration to search.
+ * @param[in] name Module name ("" for the default module).
+ * @return The threshold of the longest matching rule, or `module_default`.
+ */
+mu_log_level_t mu_log_cfg_module_threshold(const mu_log_config_t *config,
+                                           const char *name);
+
+/**
+ * @brief Returns the sinks that take a module's record at a given level.
+ *
+ * Checks each sink's threshold and module filter, not the module table.
+ *
+ * @param[in] config The configuration to search.
+ * @param[in] name Module name ("" for the default module).
+ * @param[in] level Log severity level.
+ * @return Bit i set: `config->sinks[i]` takes the record.
+ */
+unsigned mu_log_cfg_sink_mask(const mu_log_config_t *config, const char *name,
+                              mu_log_level_t level);
+
+#ifdef MU_LOG_ROUTES
+/**
+ * @brief Fills a call site's per-level routes from the current snapshot.
+ *
+ * Levels below `threshold` get no sinks.  Used by `mu_log_site_resolve()`.
+ *
+ * @param[in,out] site The call site.
+ * @param[in] threshold The site's module threshold.
+ */
+void mu_log_cfg_route_site(mu_log_site_t *site, mu_log_level_t threshold);
+#endif
+
+/**
+ * @brief Returns the current snapshot.
+ *
+ * Valid until the calling (registered) thread's next quiescent state.
+ */
+const mu_log_config_t *mu_log_cfg_current(void);
+
+/**
+ * @brief Registers the calling thread as a reader.
+ *
+ * @return A reader id for `mu_log_cfg_quiescent()`, or -1 if the reader
+ *         table is full.
+ */
+int mu_log_cfg_register_reader(void);
+
+/**
+ * @brief Unregisters a reader; it must not use snapshots afterwards.
+ */
+void mu_log_cfg_unregister_reader(int reader);
+
+/**
+ * @brief Reports that the reader holds no snapshot.
+ *
+ * Writes only the reader's own cache line.
+ */
+void mu_log_cfg_quiescent(int reader);
+
+/**
+ * @brief Returns retired snapshots that no reader can still hold to the
+ * pool.  `mu_log_cfg_publish()` calls it as needed.
+ *
+ * @return The number of snapshots reclaimed.
+ */
+size_t mu_log_cfg_reclaim(void);
+
+/**
+ * @brief A logging function that passes each record to every sink of the
+ * current snapshot whose threshold it meets.
+ *
+ * The record counts as the default module's, so sinks limited to other
+ * modules do not get it; `MU_LOG_ROUTES` call sites route by their own
+ * module instead.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @param[in] ap Argument list for formatted logging.
+ * @return Sum of the sinks' return values.
+ */
+int mu_log_cfg_fn(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_CFG_H_ */
@@ -0,0 +1,114 @@
+/**
+ * @file mu_log_evt.h
+ * @brief Log draining from an application's own event loop (Linux).
+ *
+ * Producers write records into the mu_log_buf ring (see mu_log_buf.h) and
+ * signal an `eventfd`; the application adds that descriptor to its epoll set
+ * and, when it is readable, calls `mu_log_evt_drain()` to write a bounded
+ * number of records.  Log I/O then happens on the loop's own thread, between
+ * requests, with no drain thread and no locks:
+ *
+ * ```c
+ * mu_log_buf_init(16384);
+ * int log_fd = mu_log_evt_init(mu_log_buf_stdout_writer, NULL);
+ * MU_LOG_SET_FN(mu_log_evt_fn);
+ * epoll_ctl(ep, EPOLL_CTL_ADD, log_fd, &(struct epoll_event){EPOLLIN, ...});
+ * for (;;) {
+ *     int n = epoll_wait(ep, events, N_EVENTS, -1);
+ *     // ... handle requests first ...
+ *     if (log_fd_ready) {
+ *         mu_log_evt_drain(32);    // at most 32 records per iteration
+ *     }
+ * }
+ * ```
+ *
+ * Only the first record after a drain writes to the `eventfd`; later ones
+ * cost an atomic exchange.  A drain that stops at its budget signals again,
+ * so the loop comes back for the rest.
+ */
+
+#ifndef _MU_LOG_EVT_H_
+#define _MU_LOG_EVT_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_buf.h"
+
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Creates the `eventfd` and sets the writer used by the drain.
+ *
+ * Call once, after `mu_log_buf_init()` and before logging starts.
+ *
+ * @param[in] write Writer for each drained record.
+ * @param[in] arg User argument passed to `write`.
+ * @return The descriptor to add to the epoll set (readable when records are
+ *         waiting), or -1 on failure.
+ */
+int mu_log_evt_init(mu_log_buf_writer_fn write, void *arg);
+
+/**
+ * @brief Closes the `eventfd`.  Records still in the ring stay there.
+ */
+void mu_log_evt_close(void);
+
+/**
+ * @brief Signals the event loop that records are waiting.
+ *
+ * `mu_log_evt_fn` calls it; call it after `mu_log_commit()` when writing to
+ * the ring directly.  Safe from any thread.
+ */
+void mu_log_evt_notify(void);
+
+/**
+ * @brief Writes up to `budget` records; call from the event loop when the
+ * descriptor is readable.
+ *
+ * Single consumer: call from the loop's thread only.
+ *
+ * @param[in] budget Maximum records to write, or 0 for all available.
+ * @return Number of records written.
+ */
+size_t mu_log_evt_drain(size_t budget);
+
+/**
+ * @brief A logging function that writes each line into the ring and
+ * signals the event loop.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @param[in] ap Argument list for formatted logging.
+ * @return Number of characters buffered.
+ */
+int mu_log_evt_fn(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_EVT_H_ */
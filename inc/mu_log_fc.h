@@ -0,0 +1,112 @@
+/**
+ * @file mu_log_fc.h
+ * @brief Synchronous, batched output from many threads by flat combining
+ * (POSIX).
+ *
+ * `mu_log_stdout_fn` called from many threads serializes them on the stdio
+ * lock and makes one system call per line.  `mu_log_fc_fn` renders the line
+ * into a free publication slot instead, then either takes the combiner lock
+ * or waits.  The combiner writes every published line, its own and the
+ * waiters', with a single `writev()`:
+ *
+ * ```c
+ * mu_log_fc_init(STDOUT_FILENO);
+ * MU_LOG_SET_FN(mu_log_fc_fn);
+ * ```
+ *
+ * A call returns once its line has been written, so output stays
+ * synchronous: no drain thread, and nothing is lost if the process exits
+ * right after logging.  Each thread's lines keep their order; lines from
+ * different threads written in the same batch appear in slot order.  The
+ * descriptor is written directly, bypassing (and not flushing) stdio.
+ *
+ * The slots take `MU_LOG_FC_SLOTS` cache-line-aligned lines of
+ * `MU_LOG_FC_LINE_MAX` bytes (3 KB by default) from `mu_log_alloc()`.
+ */
+
+#ifndef _MU_LOG_FC_H_
+#define _MU_LOG_FC_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_FC_SLOTS
+#define MU_LOG_FC_SLOTS 16 /**< Publication slots: the largest batch */
+#endif
+
+#ifndef MU_LOG_FC_LINE_MAX
+#define MU_LOG_FC_LINE_MAX 184 /**< Longest line, newline included */
+#endif
+
+#ifndef MU_LOG_FC_THREAD_LOCAL
+/** Storage class of each thread's preferred slot; define empty on targets
+ *  without TLS support. */
+#define MU_LOG_FC_THREAD_LOCAL _Thread_local
+#endif
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Allocates the slots (through `mu_log_alloc()`) and sets the output
+ * descriptor.
+ *
+ * Call before logging starts; calling again only changes the descriptor.
+ *
+ * @param[in] fd Descriptor to write to, e.g. `STDOUT_FILENO`.
+ * @return `true` on success, `false` if allocation failed.
+ */
+bool mu_log_fc_init(int fd);
+
+/**
+ * @brief Reports the lines written and the `writev()` calls that wrote them.
+ *
+ * @param[out] lines Lines written since `mu_log_fc_init()`.
+ * @param[out] writes Batches written; `lines / writes` is the batching factor.
+ */
+void mu_log_fc_stats(size_t *lines, size_t *writes);
+
+/**
+ * @brief A logging function that writes `LEVEL: message` lines, batched with
+ * those of concurrent callers.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @param[in] ap Argument list for formatted logging.
+ * @return Number of characters written, or -1 if the write failed.
+ */
+int mu_log_fc_fn(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_FC_H_ */
@@ -0,0 +1,243 @@
+/**
+ * @file mu_log_fmt.h
+ * @brief Compact stdio-free formatter and output sink for mu_log.
+ *
+ * `mu_log_stdout_fn` relies on `printf()`/`vprintf()`/`fputs()`, which pull
+ * the libc printf engine into the image and use a lot of stack.  This module
+ * provides a small replacement that covers the subset of printf used in
+ * firmware logging and writes one character at a time through a user hook
+ * (typically a UART transmit routine):
+ *
+ * - conversions: `%d %i %u %x %X %s %c %p %%`
+ * - flags and width: `-` (left-justify), `0` (zero-pad), width as digits or `*`
+ * - precision for `%s` (`%.8s`)
+ * - length modifiers: `h`, `hh`, `l`, `ll`, `z`
+ * - registered conversions: `%{name}`, e.g. `%{ipv4}` (width and `-` apply)
+ *
+ * Unsupported conversions are echoed verbatim.  Floating-point conversions
+ * (`%f %e %g %a`, upper case, `l` and `L`) are echoed too, but consume their
+ * `double` (or `long double`) argument, so the arguments after them still
+ * print; any other unsupported conversion consumes nothing, and every
+ * argument after it is misread.  Stack use is bounded: no
+ * recursion, one 24-byte digit buffer and one `MU_LOG_FMT_CONV_MAX`-byte
+ * buffer for registered conversions.
+ *
+ * A registered conversion takes one `uintptr_t` argument: the value itself
+ * when it fits (an IPv4 address, a duration), otherwise a pointer to it.  The
+ * renderer runs only when the line is formatted, so a suppressed call, or an
+ * `MU_LOG_ISR()` record still in the ring, pays nothing for it.  A pointed-to
+ * value must outlive the drain, as a `%s` string does.
+ */
+
+#ifndef _MU_LOG_FMT_H_
+#define _MU_LOG_FMT_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @typedef mu_log_putc_hook
+ * @brief Writes one character to the output device.
+ *
+ * @param[in] ch The character to write.
+ * @param[in] arg The user argument given to `mu_log_set_putc()`.
+ */
+typedef void (*mu_log_putc_hook)(char ch, void *arg);
+
+#ifndef MU_LOG_FMT_MAX_CONVS
+#define MU_LOG_FMT_MAX_CONVS 8 /**< Registered `%{name}` conversions; 0: none */
+#endif
+
+#ifndef MU_LOG_FMT_CONV_MAX
+#define MU_LOG_FMT_CONV_MAX 48 /**< Longest registered conversion output */
+#endif
+
+#ifndef MU_LOG_FMT_PLANS
+#define MU_LOG_FMT_PLANS 0 /**< Cached render plans (power of two); 0: none */
+#endif
+
+#ifndef MU_LOG_FMT_PLAN_OPS
+#define MU_LOG_FMT_PLAN_OPS 16 /**< Most literal runs + conversions per plan */
+#endif
+
+/**
+ * @typedef mu_log_fmt_conv_fn
+ * @brief Renders one `%{name}` argument.
+ *
+ * @param[out] buf Where to write the text (not NUL-terminated).
+ * @param[in] size Size of `buf`, `MU_LOG_FMT_CONV_MAX`.
+ * @param[in] value The argument: the value or a pointer to it.
+ * @return Number of characters written, at most `size`.
+ */
+typedef size_t (*mu_log_fmt_conv_fn)(char *buf, size_t size, uintptr_t value);
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Formats a string, writing each character through `putc`.
+ *
+ * @param[in] putc Character output hook.
+ * @param[in] arg User argument passed to each `putc` call.
+ * @param[in] format printf-style format (see the supported subset above).
+ * @param[in] ap Arguments for the format.
+ * @return Number of characters written.
+ */
+int mu_log_fmt_vformat(mu_log_putc_hook putc, void *arg, const char *format,
+                       va_list ap);
+
+/**
+ * @brief Formats from an array of machine words instead of a va_list.
+ *
+ * Used to render records whose arguments were captured earlier (see
+ * `mu_log_isr.h`).  Each conversion, and each `*` width or precision, consumes
+ * one word: integers are narrowed to the conversion's type, `%s` and `%p`
+ * reinterpret the word as a pointer.  Missing words read as 0.
+ *
+ * @param[in] putc Character output hook.
+ * @param[in] arg User argument passed to each `putc` call.
+ * @param[in] format printf-style format (see the supported subset above).
+ * @param[in] words Captured arguments.
+ * @param[in] n_words Number of entries in `words`.
+ * @return Number of characters written.
+ */
+int mu_log_fmt_wformat(mu_log_putc_hook putc, void *arg, const char *format,
+                       const uintptr_t *words, size_t n_words);
+
+/**
+ * @brief Formats into a buffer, like `vsnprintf()`.
+ *
+ * The output is always NUL-terminated when `size > 0`.
+ *
+ * @return The length the full output would have had (excluding the NUL).
+ */
+int mu_log_fmt_vsnprintf(char *buf, size_t size, const char *format,
+                         va_list ap);
+
+/**
+ * @brief Formats from an array of machine words into a buffer.
+ *
+ * @see mu_log_fmt_wformat(), mu_log_fmt_vsnprintf()
+ */
+int mu_log_fmt_wsnprintf(char *buf, size_t size, const char *format,
+                         const uintptr_t *words, size_t n_words);
+
+/**
+ * @brief Formats into a buffer, like `snprintf()`.
+ */
+int mu_log_fmt_snprintf(char *buf, size_t size, const char *format, ...);
+
+/**
+ * @brief Registers (or replaces) the renderer for `%{name}`.
+ *
+ * Register at startup, before logging begins; the table is not locked.
+ *
+ * @param[in] name Conversion name; must outlive the registration.
+ * @param[in] conv The renderer.
+ * @return `true` on success, `false` if the table is full.
+ */
+bool mu_log_fmt_register(const char *name, mu_log_fmt_conv_fn conv);
+
+/**
+ * @brief Registers the renderers below as `%{ipv4}`, `%{ipv6}`, `%{uuid}` and
+ * `%{dur_ns}`.
+ *
+ * @return `true` if all four fit in the table.
+ */
+bool mu_log_fmt_register_builtins(void);
+
+/**
+ * @brief Renders an IPv4 address given in host byte order
+ * (`ntohl(in.s_addr)`) as `a.b.c.d`.
+ */
+size_t mu_log_fmt_ipv4(char *buf, size_t size, uintptr_t value);
+
+/**
+ * @brief Renders the IPv6 address at `(const uint8_t *)value` (16 bytes,
+ * network order) in RFC 5952 form.
+ */
+size_t mu_log_fmt_ipv6(char *buf, size_t size, uintptr_t value);
+
+/**
+ * @brief Renders the UUID at `(const uint8_t *)value` (16 bytes) as
+ * `8-4-4-4-12` lowercase hex.
+ */
+size_t mu_log_fmt_uuid(char *buf, size_t size, uintptr_t value);
+
+/**
+ * @brief Renders a duration in nanoseconds as `ns`, `us`, `ms` or `s`, with
+ * three decimals above 1000 ns (`1.500ms`).
+ */
+size_t mu_log_fmt_dur_ns(char *buf, size_t size, uintptr_t value);
+
+/**
+ * @brief Reports the render-plan cache's hits and misses since startup.
+ *
+ * With `MU_LOG_FMT_PLANS` > 0, each format pointer is parsed once into a plan
+ * of literal runs and conversions, which later calls with the same pointer
+ * replay without parsing.  The cache is lock-free and never evicts: once
+ * `MU_LOG_FMT_PLANS` formats are cached, or for a format of more than
+ * `MU_LOG_FMT_PLAN_OPS` steps, every call is a miss and parses as before.
+ * Formats must not change while cached, as with `MU_LOG_ISR()` records.
+ * A miss parses into a plan on the stack, 16 bytes per step.
+ *
+ * @param[out] hits Renders that replayed a cached plan.
+ * @param[out] misses Renders that parsed the format.
+ */
+void mu_log_fmt_plan_stats(size_t *hits, size_t *misses);
+
+/**
+ * @brief Sets the character output hook used by `mu_log_putc_fn`.
+ *
+ * @param[in] putc Character output hook, or NULL to discard output.
+ * @param[in] arg User argument passed to each `putc` call.
+ */
+void mu_log_set_putc(mu_log_putc_hook putc, void *arg);
+
+/**
+ * @brief A logging function that writes through the putc hook, without stdio.
+ *
+ * Produces the same `LEVEL: message\n` lines as `mu_log_stdout_fn`.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string (if formatted logging is enabled) or message.
+ * @param[in] ap Argument list for formatted logging.
+ * @return Number of characters written.
+ */
+int mu_log_putc_fn(mu_log_level_t level,
+  #ifdef MU_LOG_ENABLE_FORMATTED
+    const char *format, va_list ap
+  #else
+    const char *message
+  #endif
+);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_FMT_H_ */
@@ -0,0 +1,172 @@
+/**
+ * @file mu_log_isr.h
+ * @brief Interrupt-safe deferred logging.
+ *
+ * `mu_log()` runs the sink in the caller's context, which is wrong inside an
+ * interrupt handler: UART output or printf would run with interrupts masked.
+ * `MU_LOG_ISR()` instead copies the record -- level, format pointer and up to
+ * `MU_LOG_ISR_MAX_ARGS` word-sized arguments -- into a fixed ring and returns.
+ * `mu_log_isr_drain()`, called from the idle loop or a low-priority task,
+ * formats the queued records and hands them to the regular sink.
+ *
+ * The ring is lock-free: producers reserve a slot with a compare-and-swap and
+ * publish it with a release store of the slot's sequence number, so a handler
+ * may interrupt another producer (or the drain) at any point.  On cores
+ * without a native compare-and-swap (e.g. Cortex-M0), define
+ * `MU_LOG_ISR_ENTER_CRITICAL(state)` and `MU_LOG_ISR_EXIT_CRITICAL(state)`
+ * and the ring is guarded by those instead of atomics.  Enter saves the
+ * interrupt state in `state` (a `MU_LOG_ISR_CRITICAL_STATE`, `uint32_t` by
+ * default) and masks interrupts; exit restores it, so a producer that runs
+ * with interrupts already masked leaves them masked:
+ *
+ * ```c
+ * #define MU_LOG_ISR_ENTER_CRITICAL(state)                                   \
+ *     do { (state) = __get_PRIMASK(); __disable_irq(); } while (0)
+ * #define MU_LOG_ISR_EXIT_CRITICAL(state) __set_PRIMASK(state)
+ * ```
+ *
+ * Arguments are captured by value as `uintptr_t`.  Pass integers, characters
+ * and pointers; `%s` arguments must outlive the drain (string literals or
+ * static buffers).  Records are rendered with the mu_log_fmt formatter, so
+ * the same conversion subset applies.  In simple (non-formatted) mode a
+ * record without arguments reaches the sink as the original message pointer.
+ *
+ * ```c
+ * void TIMER_IRQHandler(void) {
+ *     MU_LOG_ISR(MU_LOG_LEVEL_DEBUG, "tick %u, adc=%d", ticks, adc_read());
+ * }
+ *
+ * void idle_loop(void) {
+ *     mu_log_isr_drain(0);
+ * }
+ * ```
+ */
+
+#ifndef _MU_LOG_ISR_H_
+#define _MU_LOG_ISR_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_ISR_CAPACITY
+#define MU_LOG_ISR_CAPACITY 32 /**< Ring slots; must be a power of two */
+#endif
+
+#define MU_LOG_ISR_MAX_ARGS 4 /**< Word arguments captured per record */
+
+#ifndef MU_LOG_ISR_LINE_MAX
+#define MU_LOG_ISR_LINE_MAX 128 /**< Rendered line size used by the drain */
+#endif
+
+#ifndef MU_LOG_ISR_CRITICAL_STATE
+#define MU_LOG_ISR_CRITICAL_STATE uint32_t /**< Saved interrupt state */
+#endif
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Empties the ring and clears the drop counter.
+ *
+ * The first call allocates the ring through `mu_log_alloc()` (see
+ * mu_log_mem.h); records posted before that, or if the allocation failed,
+ * are counted as dropped.  Not interrupt-safe; call before enabling the
+ * interrupts that log.
+ */
+void mu_log_isr_init(void);
+
+/**
+ * @brief Queues a record.  Safe to call from interrupt (and signal) context.
+ *
+ * Records below the current threshold are not queued.  Prefer the
+ * `MU_LOG_ISR()` macro, which counts and casts the arguments.
+ *
+ * @param[in] level Log severity level.
+ * @param[in] format Format string or message; must outlive the drain.
+ * @param[in] n_args Number of valid entries among `a0` .. `a3`.
+ * @return `true` if queued, `false` if filtered out or the ring was full.
+ */
+bool mu_log_isr_post(mu_log_level_t level, const char *format, size_t n_args,
+                     uintptr_t a0, uintptr_t a1, uintptr_t a2, uintptr_t a3);
+
+/**
+ * @brief Formats queued records and passes them to the current sink.
+ *
+ * Must be called from a single, non-interrupt context.  If records were
+ * dropped since the previous drain, a WARN record reporting how many is
+ * emitted first.
+ *
+ * @param[in] max_records Maximum records to emit, or 0 for all queued.
+ * @return Number of records emitted.
+ */
+size_t mu_log_isr_drain(size_t max_records);
+
+/**
+ * @brief Returns the number of records dropped because the ring was full.
+ */
+size_t mu_log_isr_dropped(void);
+
+// *****************************************************************************
+// Logging Macros
+
+/**
+ * @brief Queues a log record from interrupt context.
+ *
+ * `MU_LOG_ISR(level, format, ...)` accepts up to four arguments.
+ */
+#define MU_LOG_ISR(level, ...)                                                 \
+    MU_LOG_ISR_CAT(MU_LOG_ISR_, MU_LOG_ISR_NARGS(__VA_ARGS__))(level, __VA_ARGS__)
+
+#define MU_LOG_ISR_NARGS(...) MU_LOG_ISR_NARGS_(__VA_ARGS__, 4, 3, 2, 1, 0, ~)
+#define MU_LOG_ISR_NARGS_(_f, _1, _2, _3, _4, n, ...) n
+#define MU_LOG_ISR_CAT(a, b) MU_LOG_ISR_CAT_(a, b)
+#define MU_LOG_ISR_CAT_(a, b) a##b
+#define MU_LOG_ISR_W(x) ((uintptr_t)(x))
+
+#define MU_LOG_ISR_0(l, f) mu_log_isr_post(l, f, 0, 0, 0, 0, 0)
+#define MU_LOG_ISR_1(l, f, a)                                                  \
+    mu_log_isr_post(l, f, 1, MU_LOG_ISR_W(a), 0, 0, 0)
+#define MU_LOG_ISR_2(l, f, a, b)                                               \
+    mu_log_isr_post(l, f, 2, MU_LOG_ISR_W(a), MU_LOG_ISR_W(b), 0, 0)
+#define MU_LOG_ISR_3(l, f, a, b, c)                                            \
+    mu_log_isr_post(l, f, 3, MU_LOG_ISR_W(a), MU_LOG_ISR_W(b),                 \
+                    MU_LOG_ISR_W(c), 0)
+#define MU_LOG_ISR_4(l, f, a, b, c, d)                                         \
+    mu_log_isr_post(l, f, 4, MU_LOG_ISR_W(a), MU_LOG_ISR_W(b),                 \
+                    MU_LOG_ISR_W(c), MU_LOG_ISR_W(d))
+
+#define MU_LOG_ISR_DRAIN(max) mu_log_isr_drain(max) /**< Drains the ring */
+
+#else
+
+/** No-op macros when logging is disabled */
+#define MU_LOG_ISR(level, ...) ((void)0)
+#define MU_LOG_ISR_DRAIN(max) ((void)0)
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_ISR_H_ */
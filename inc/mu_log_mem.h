@@ -0,0 +1,158 @@
+/**
+ * @file mu_log_mem.h
+ * @brief Allocator hooks and a bump arena for mu_log's internal buffers.
+ *
+ * mu_log never calls `malloc()`.  Modules that need a buffer (the interrupt
+ * ring in `mu_log_isr.c`, for example) take it from the allocator set here,
+ * once, when they are initialized.  By default that is a built-in bump arena
+ * over `MU_LOG_ARENA_SIZE` bytes of static storage, so logging memory is
+ * preallocated, contiguous and accounted for.  Services with their own memory
+ * management install an allocator before initializing any module:
+ *
+ * ```c
+ * static void *my_alloc(void *ctx, size_t size, size_t align) {
+ *     return je_aligned_alloc(align, size);
+ * }
+ * static void my_free(void *ctx, void *ptr, size_t size) {
+ *     je_free(ptr);
+ * }
+ *
+ * mu_log_allocator_t a = {my_alloc, my_free, NULL};
+ * mu_log_set_allocator(&a);
+ * ```
+ *
+ * Allocation happens in the modules' init functions, not on the logging path.
+ * The allocator is not locked: call the init functions from one thread.
+ */
+
+#ifndef _MU_LOG_MEM_H_
+#define _MU_LOG_MEM_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_ARENA_SIZE
+#define MU_LOG_ARENA_SIZE 4096 /**< Size of the default arena, in bytes */
+#endif
+
+/**
+ * @brief Allocates `size` bytes aligned to `align` (a power of two).
+ * @return The block, or NULL if it cannot be satisfied.
+ */
+typedef void *(*mu_log_alloc_fn)(void *ctx, size_t size, size_t align);
+
+/**
+ * @brief Releases a block returned by the matching `mu_log_alloc_fn`.
+ */
+typedef void (*mu_log_free_fn)(void *ctx, void *ptr, size_t size);
+
+/**
+ * @struct mu_log_allocator_t
+ * @brief An allocator: two hooks and the context passed to both.
+ */
+typedef struct {
+    mu_log_alloc_fn alloc; /**< Allocation hook */
+    mu_log_free_fn free;   /**< Release hook (may be a no-op) */
+    void *ctx;             /**< User context */
+} mu_log_allocator_t;
+
+/**
+ * @struct mu_log_arena_t
+ * @brief A bump arena over a caller-supplied buffer.
+ *
+ * Blocks are carved off in order and only the most recent one can be given
+ * back; everything else lives until `mu_log_arena_reset()`.
+ */
+typedef struct {
+    unsigned char *base; /**< Start of the buffer */
+    size_t size;         /**< Buffer size, in bytes */
+    size_t used;         /**< Bytes in use, including alignment padding */
+    size_t high_water;   /**< Largest `used` seen */
+    size_t n_allocs;     /**< Successful allocations */
+    size_t n_failed;     /**< Allocations refused for lack of space */
+} mu_log_arena_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Sets the allocator used for every internal buffer.
+ *
+ * Must be called before the first internal allocation; afterwards the
+ * allocator is fixed, since blocks must be released to the allocator that
+ * produced them.
+ *
+ * @param[in] allocator The allocator (copied), or NULL for the default arena.
+ * @return `true` if set, `false` if an allocation has already been made.
+ */
+bool mu_log_set_allocator(const mu_log_allocator_t *allocator);
+
+/**
+ * @brief Allocates an internal buffer from the current allocator.
+ *
+ * @param[in] size Size in bytes.
+ * @param[in] align Alignment, a power of two.
+ * @return The block, or NULL.
+ */
+void *mu_log_alloc(size_t size, size_t align);
+
+/**
+ * @brief Releases a block obtained from `mu_log_alloc()`.
+ */
+void mu_log_free(void *ptr, size_t size);
+
+/**
+ * @brief Returns the built-in arena backing the default allocator, e.g. to
+ * report its `used` and `high_water` figures.
+ */
+const mu_log_arena_t *mu_log_default_arena(void);
+
+/**
+ * @brief Initializes an arena over `buf`.
+ */
+void mu_log_arena_init(mu_log_arena_t *arena, void *buf, size_t size);
+
+/**
+ * @brief Returns an allocator that draws from `arena`.
+ */
+mu_log_allocator_t mu_log_arena_allocator(mu_log_arena_t *arena);
+
+/**
+ * @brief Allocates from an arena.
+ *
+ * @return The block, or NULL (counted in `n_failed`) if it does not fit.
+ */
+void *mu_log_arena_alloc(mu_log_arena_t *arena, size_t size, size_t align);
+
+/**
+ * @brief Releases all blocks, keeping the high-water mark.
+ */
+void mu_log_arena_reset(mu_log_arena_t *arena);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_MEM_H_ */
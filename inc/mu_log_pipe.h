@@ -0,0 +1,131 @@
+/**
+ * @file mu_log_pipe.h
+ * @brief Buffered drain writer that gifts whole pages to a pipe (Linux).
+ *
+ * `mu_log_buf_stdout_writer` hands each record to stdio, which copies it
+ * into its buffer and again into the kernel on every flush.  In a container
+ * stdout is usually a pipe to the log collector, and at high volume those
+ * copies are most of the writer's CPU time.  `mu_log_pipe_writer` collects
+ * `LEVEL: message` lines in page-aligned buffers of `MU_LOG_PIPE_BUF_SIZE`
+ * bytes.  When a buffer fills, its whole pages go to the pipe with
+ * `vmsplice(SPLICE_F_GIFT)`, so the kernel references them instead of
+ * copying.  Any partial page is `write()`n.  When the descriptor is not a pipe
+ * (a file, a terminal), or zero copy is off or refused, buffers are
+ * `write()`n, which still makes one system call per buffer:
+ *
+ * ```c
+ * mu_log_buf_init(65536);
+ * mu_log_pipe_init(STDOUT_FILENO, true);
+ * MU_LOG_SET_FN(mu_log_buf_fn);
+ * // drain thread:
+ * mu_log_buf_drain(mu_log_pipe_writer, NULL, 0);
+ * mu_log_pipe_flush();
+ * ```
+ *
+ * A gifted page must not change while the pipe still holds it.  A pipe holds
+ * at most one page per slot (`F_GETPIPE_SZ` / page size), so a buffer is
+ * written again only after that many further pages have been spliced after
+ * it.  A buffer reused sooner, after a run of small flushes, gets fresh
+ * anonymous pages mapped over it first; if that mapping fails, the writer
+ * waits for the pipe to empty and copies from then on.  The rule covers
+ * collectors that `read()` the pipe or splice it into a file.  A collector
+ * that `tee()`s the pipe or splices it into a socket may hold pages longer;
+ * use the copying path there.
+ *
+ * Single consumer: the writer and `mu_log_pipe_flush()` run on the drain
+ * thread only.
+ */
+
+#ifndef _MU_LOG_PIPE_H_
+#define _MU_LOG_PIPE_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_PIPE_BUF_SIZE
+#define MU_LOG_PIPE_BUF_SIZE 65536 /**< Bytes per buffer; whole pages */
+#endif
+
+#ifndef MU_LOG_PIPE_MAX_BUFS
+#define MU_LOG_PIPE_MAX_BUFS 8 /**< Most buffers in the rotation */
+#endif
+
+/**
+ * @struct mu_log_pipe_stats_t
+ * @brief Where the written bytes went.
+ */
+typedef struct {
+    uint64_t spliced; /**< Bytes gifted with vmsplice() */
+    uint64_t written; /**< Bytes copied with write() */
+    uint64_t remaps;  /**< Buffers given fresh pages before reuse */
+} mu_log_pipe_stats_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Maps the buffers and sets the output descriptor.
+ *
+ * Call once, before the first drain.
+ *
+ * @param[in] fd Descriptor to write to, e.g. `STDOUT_FILENO`.
+ * @param[in] zero_copy Gift pages with `vmsplice()` if `fd` is a pipe.
+ * @return `true` on success, `false` if `MU_LOG_PIPE_BUF_SIZE` is not a
+ *         multiple of the page size or the buffers could not be mapped.
+ */
+bool mu_log_pipe_init(int fd, bool zero_copy);
+
+/**
+ * @brief Unmaps the buffers, after writing what they hold.
+ */
+void mu_log_pipe_close(void);
+
+/**
+ * @brief A drain writer (see `mu_log_buf_drain()`) that appends one
+ * `LEVEL: message` line to the current buffer, sending the buffer when full.
+ *
+ * A line longer than a buffer is written on its own.
+ */
+void mu_log_pipe_writer(mu_log_level_t level, const char *data, size_t len,
+                        void *arg);
+
+/**
+ * @brief Sends the lines buffered so far; call after each drain.
+ *
+ * @return `false` if a write failed; the buffered lines are then dropped.
+ */
+bool mu_log_pipe_flush(void);
+
+/**
+ * @brief Reports bytes spliced and written since `mu_log_pipe_init()`.
+ */
+void mu_log_pipe_stats(mu_log_pipe_stats_t *stats);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_PIPE_H_ */
@@ -0,0 +1,106 @@
+/**
+ * @file mu_log_shm.h
+ * @brief A shared-memory control page for changing levels from outside the
+ * process.
+ *
+ * Built with `MU_LOG_SHM` (see mu_log.h), the global threshold, per-module
+ * threshold overrides and an enable bit per call site live in
+ * `mu_log_shm_page`.  `mu_log_shm_init()` publishes it as the POSIX shared
+ * memory object `/mu_log.<pid>`, so a tool (`tools/mu_log_ctl`) can attach
+ * and change the page while the process runs.  The process never polls: the
+ * level checks read the page with plain loads, and a call site refreshes its
+ * cached module threshold and enable bit only when the page's `generation`
+ * changes.
+ *
+ * Modules and call sites are listed in the page the first time each one
+ * logs or checks its level.  A child created by `fork()` shares the page
+ * with its parent; both append to its tables under the lock kept in the page
+ * itself (`tables_lock`).
+ */
+
+#ifndef _MU_LOG_SHM_H_
+#define _MU_LOG_SHM_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+
+#include <stdbool.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_SHM) && (defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED)) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_LOG_SHM_NAME_FORMAT "/mu_log.%d" /**< shm_open() name per PID */
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Shares the control page as `/mu_log.<pid>`.
+ *
+ * Call once, early, before other threads log.
+ *
+ * @return `true` on success.
+ */
+bool mu_log_shm_init(void);
+
+/**
+ * @brief Removes the page's name; the page itself stays in use.
+ *
+ * Call at exit so the name does not outlive the process.
+ */
+void mu_log_shm_close(void);
+
+/**
+ * @brief Maps another process's control page (for tools).
+ *
+ * @param[in] pid The process that called `mu_log_shm_init()`.
+ * @return The page, or NULL if it does not exist or is not compatible.
+ */
+mu_log_shm_page_t *mu_log_shm_attach(int pid);
+
+/**
+ * @brief Unmaps a page from `mu_log_shm_attach()`.
+ */
+void mu_log_shm_detach(mu_log_shm_page_t *page);
+
+/**
+ * @brief Sets or clears a module's threshold override.
+ *
+ * @param[in] page The control page.
+ * @param[in] module Index into `page->modules`.
+ * @param[in] threshold A level, or `MU_LOG_SHM_NO_OVERRIDE` to use the
+ *            mu_log_cfg module table again.
+ */
+void mu_log_shm_set_module(mu_log_shm_page_t *page, int module,
+                           int threshold);
+
+/**
+ * @brief Enables or silences a call site.
+ *
+ * @param[in] page The control page.
+ * @param[in] site Index into `page->sites`.
+ * @param[in] enabled `false` to silence the site.
+ */
+void mu_log_shm_set_site(mu_log_shm_page_t *page, int site, bool enabled);
+
+#endif  /**< End of MU_LOG_SHM and (MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED) */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_SHM_H_ */
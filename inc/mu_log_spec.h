@@ -0,0 +1,139 @@
+/**
+ * @file mu_log_spec.h
+ * @brief Per-module levels from a spec string, with live reload and expiry.
+ *
+ * A spec lists comma-separated `module=level` rules, e.g.
+ * `*=info,net=debug,db.pool=trace`.  `*` (or a bare level) sets the default
+ * module's level, a rule covers the named module and those below it ("net"
+ * covers "net.tcp"), and a `:<seconds>` suffix (`net=debug:300`) makes the
+ * rule expire, so the module reverts to the next matching rule.  Levels are
+ * the level names, in any case.
+ *
+ * The rules replace the module table of the current mu_log_cfg snapshot
+ * (call `mu_log_cfg_init()` first) and are published with its atomic swap.
+ * Call sites pick them up when built with `MU_LOG_MODULES` (see mu_log.h).
+ *
+ * `mu_log_spec_init()` applies the `MU_LOG` environment variable.  A reload --
+ * of the watched file if there is one, otherwise of the environment -- is
+ * requested by SIGHUP (`mu_log_spec_watch_sighup()`) or, on Linux, by a
+ * change to the file (`mu_log_spec_watch_file()`, via inotify), and performed
+ * by the next `mu_log_spec_poll()`, which also expires rules.  Call it
+ * periodically from the main loop or a housekeeping thread.
+ */
+
+#ifndef _MU_LOG_SPEC_H_
+#define _MU_LOG_SPEC_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_cfg.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_LOG_SPEC_ENV
+#define MU_LOG_SPEC_ENV "MU_LOG" /**< Environment variable holding the spec */
+#endif
+
+#ifndef MU_LOG_SPEC_MAX
+#define MU_LOG_SPEC_MAX 256 /**< Longest spec read from a file */
+#endif
+
+/**
+ * @brief Returns a monotonic time in milliseconds, for rule expiry.
+ */
+typedef uint64_t (*mu_log_spec_clock_fn)(void);
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Parses a spec into the module table of `config`.
+ *
+ * The sinks in `config` are left alone.  Modules without a rule, when the
+ * spec has no `*` rule, get `MU_LOG_DEFAULT_LEVEL`.
+ *
+ * @param[in] spec The spec string.
+ * @param[in,out] config Configuration whose module table is replaced.
+ * @return `true` on success; `false` (leaving `config` unchanged) if the
+ *         spec is malformed, has too many rules, or uses an expiry without
+ *         a clock.
+ */
+bool mu_log_spec_parse(const char *spec, mu_log_config_t *config);
+
+/**
+ * @brief Parses a spec and publishes it as the current module table.
+ *
+ * @param[in] spec The spec string.
+ * @return `true` if the spec was valid and published.
+ */
+bool mu_log_spec_apply(const char *spec);
+
+/**
+ * @brief Applies the spec in the `MU_LOG_SPEC_ENV` environment variable.
+ *
+ * @return `true` if the variable is unset or was applied.
+ */
+bool mu_log_spec_init(void);
+
+/**
+ * @brief Sets the clock used for rule expiry.
+ *
+ * Defaults to `CLOCK_MONOTONIC` on POSIX systems, and to none (expiry
+ * unsupported) elsewhere.
+ */
+void mu_log_spec_set_clock(mu_log_spec_clock_fn clock);
+
+/**
+ * @brief Requests a reload at the next `mu_log_spec_poll()`.
+ *
+ * Async-signal-safe.
+ */
+void mu_log_spec_request_reload(void);
+
+/**
+ * @brief Installs a SIGHUP handler that requests a reload (POSIX only).
+ *
+ * @return `true` if the handler was installed.
+ */
+bool mu_log_spec_watch_sighup(void);
+
+/**
+ * @brief Makes `path` the spec source, applies it, and on Linux watches it
+ * for changes.
+ *
+ * @param[in] path The spec file; one spec, surrounding whitespace ignored.
+ * @return `true` if the file was read and applied.
+ */
+bool mu_log_spec_watch_file(const char *path);
+
+/**
+ * @brief Performs a requested reload and drops expired rules.
+ *
+ * @return `true` if a new module table was published.
+ */
+bool mu_log_spec_poll(void);
+
+#endif  /**< End of MU_LOG_ENABLE or MU_LOG_ENABLE_FORMATTED */
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MU_LOG_SPEC_H_ */
@@ -25,127 +25,10 @@
 // *****************************************************************************
 // Includes
 
+// The implementation lives in mu_log.h so that it can also be used as a single
+// header (see MU_LOG_IMPLEMENTATION there).
+#define MU_LOG_IMPLEMENTATION
 #include "mu_log.h"
 
-#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
-
-#include <stddef.h>
-#include <stdio.h>
-
-// *****************************************************************************
-// Private types and definitions
-
-// *****************************************************************************
-// Private (forward) declarations
-
-// *****************************************************************************
-// Private (static) storage
-
-static mu_log_t s_logger = { 
-    .log_fn = NULL, 
-    .threshold = MU_LOG_DEFAULT_LEVEL
-};
-
-// define s_level_names[], an array that maps a logging level to a string
-#define EXPAND_LEVEL_NAMES(_enum_id, _name) _name,
-static const char *s_level_names[] = {MU_LOG_LEVELS(EXPAND_LEVEL_NAMES)};
-#define N_LOG_LEVELS (sizeof(s_level_names)/sizeof(s_level_names[0]))
-
-// *****************************************************************************
-// Public code
-
-void mu_log_set_fn(mu_log_fn fn) {
-    s_logger.log_fn = fn;
-}
-
-mu_log_fn mu_log_get_fn(void) {
-    return s_logger.log_fn;
-}
-
-void mu_log_set_threshold(mu_log_level_t threshold) {
-    s_logger.threshold = threshold;
-}
-
-mu_log_level_t mu_log_get_threshold(void) {
-    return s_logger.threshold;
-}
-
-#ifdef MU_LOG_ENABLE_FORMATTED
-// using formatted logging
-void mu_log(mu_log_level_t level, const char *format, ...) {
-    va_list ap;
-    va_start(ap, format);
-    s_logger.log_fn(level, format, ap);
-    va_end(ap);
-}
-
-#else
-// using simple string logging
-void mu_log(mu_log_level_t level, const char *message) {
-    s_logger.log_fn(level, message);
-}
-#endif
-
-bool mu_log_will_log(mu_log_level_t level) {
-    return (s_logger.log_fn != NULL) && (level >= s_logger.threshold);
-}
-
-const char *mu_log_level_name(mu_log_level_t level) {
-    if (level < N_LOG_LEVELS) {
-        return s_level_names[level];
-    } else {
-        return "UNKNOWN";
-    }
-}
-
-#ifdef MU_LOG_ENABLE_FORMATTED
-int mu_log_stdout_fn(mu_log_level_t level, const char *format, va_list ap) {
-    int n1, n2, n3;
-
-    if (!mu_log_will_log(level)) {
-        return 0;
-    }
-
-    n1 = printf("%5s: ", mu_log_level_name(level));
-    if (n1 < 0) return n1;
-
-    n2 = vprintf(format, ap);
-    if (n2 < 0) return n2;
-
-    n3 = printf("\n");
-    if (n3 < 0) return n3;
-
-    return n1 + n2 + n3;
-}
-
-#else
-int mu_log_stdout_fn(mu_log_level_t level, const char *message) {
-    int n;
-
-    if (!mu_log_will_log(level)) {
-        return 0;
-    }
-    n = fputs(mu_log_level_name(level), stdout);
-    if (n < 0) return n;
-
-    n = fputs(": ", stdout);
-    if (n < 0) return n;
-
-    n = fputs(message, stdout);
-    if (n < 0) return n;
-
-    n = fputs("\n", stdout);
-    if (n < 0) return n;
-
-    return n;
-}
-#endif
-
-// *****************************************************************************
-// Private (static) code
-
-
 // *****************************************************************************
 // End of file
-
-#endif
@@ -0,0 +1,264 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_brk.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define EVENT_MAX 96
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static uint64_t monotonic_ns(void);
+static int call_sink(mu_log_level_t level, const char *text, size_t len);
+static void divert(mu_log_level_t level, const char *text);
+static void trip(const char *why, uint64_t elapsed);
+static void probe(uint64_t now);
+static void replay_writer(mu_log_level_t level, const char *data, size_t len,
+                          void *arg);
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_log_fn s_sink;
+static uint64_t s_slow_ns;
+static uint64_t s_probe_ns;
+static mu_log_clock_fn s_clock = monotonic_ns;
+static _Atomic int s_state;
+static _Atomic uint64_t s_next_probe; // clock time of the next probe
+static atomic_size_t s_trips;
+static atomic_size_t s_lost;          // records a failing sink did not take
+static size_t s_dropped_at_trip;      // ring drops when the breaker opened
+static atomic_flag s_probing = ATOMIC_FLAG_INIT;
+
+// *****************************************************************************
+// Public code
+
+void mu_log_brk_init(mu_log_fn sink, uint64_t slow_ns, uint64_t probe_ns) {
+    s_sink = sink;
+    s_slow_ns = slow_ns;
+    s_probe_ns = probe_ns;
+    atomic_store(&s_state, MU_LOG_BRK_CLOSED);
+    atomic_store(&s_trips, 0);
+    atomic_store(&s_lost, 0);
+}
+
+void mu_log_brk_set_clock(mu_log_clock_fn clock) {
+    s_clock = clock != NULL ? clock : monotonic_ns;
+}
+
+mu_log_brk_state_t mu_log_brk_state(void) {
+    return (mu_log_brk_state_t)atomic_load(&s_state);
+}
+
+size_t mu_log_brk_trips(void) {
+    return atomic_load(&s_trips);
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_brk_fn(mu_log_level_t level, const char *format, va_list ap) {
+    uint64_t start, elapsed;
+    va_list aq;
+    int n;
+
+    if (atomic_load_explicit(&s_state, memory_order_relaxed) ==
+        MU_LOG_BRK_CLOSED) {
+        va_copy(aq, ap);
+        start = s_clock();
+        n = s_sink(level, format, ap);
+        elapsed = s_clock() - start;
+        if (n < 0) {
+            trip("failed", elapsed);
+            n = mu_log_buf_fn(level, format, aq); // keep the record
+        } else if (elapsed > s_slow_ns) {
+            trip("stalled", elapsed);
+        }
+        va_end(aq);
+        return n;
+    }
+    n = mu_log_buf_fn(level, format, ap);
+    probe(s_clock());
+    return n;
+}
+
+#else
+int mu_log_brk_fn(mu_log_level_t level, const char *message) {
+    uint64_t start, elapsed;
+    int n;
+
+    if (atomic_load_explicit(&s_state, memory_order_relaxed) ==
+        MU_LOG_BRK_CLOSED) {
+        start = s_clock();
+        n = s_sink(level, message);
+        elapsed = s_clock() - start;
+        if (n < 0) {
+            trip("failed", elapsed);
+            n = mu_log_buf_fn(level, message); // keep the record
+        } else if (elapsed > s_slow_ns) {
+            trip("stalled", elapsed);
+        }
+        return n;
+    }
+    n = mu_log_buf_fn(level, message);
+    probe(s_clock());
+    return n;
+}
+#endif
+
+// *****************************************************************************
+// Private (static) code
+
+static uint64_t monotonic_ns(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int call_sink_v(mu_log_level_t level, const char *format, ...) {
+    va_list ap;
+    int n;
+
+    va_start(ap, format);
+    n = s_sink(level, format, ap);
+    va_end(ap);
+    return n;
+}
+
+static int call_sink(mu_log_level_t level, const char *text, size_t len) {
+    return call_sink_v(level, "%.*s", (int)len, text);
+}
+
+static int divert_v(mu_log_level_t level, const char *format, ...) {
+    va_list ap;
+    int n;
+
+    va_start(ap, format);
+    n = mu_log_buf_fn(level, format, ap);
+    va_end(ap);
+    return n;
+}
+
+static void divert(mu_log_level_t level, const char *text) {
+    divert_v(level, "%s", text);
+}
+
+#else
+static int call_sink(mu_log_level_t level, const char *text, size_t len) {
+    // records in the ring are not NUL-terminated; probes run one at a time
+    static char line[MU_LOG_BUF_BATCH_MAX + 1];
+
+    if (len >= sizeof(line)) {
+        len = sizeof(line) - 1;
+    }
+    memcpy(line, text, len);
+    line[len] = '\0';
+    return s_sink(level, line);
+}
+
+static void divert(mu_log_level_t level, const char *text) {
+    mu_log_buf_fn(level, text);
+}
+#endif
+
+/**
+ * @brief Opens the breaker; the thread that opens it records why.
+ */
+static void trip(const char *why, uint64_t elapsed) {
+    int closed = MU_LOG_BRK_CLOSED;
+    char event[EVENT_MAX];
+
+    if (!atomic_compare_exchange_strong(&s_state, &closed, MU_LOG_BRK_OPEN)) {
+        return;
+    }
+    atomic_fetch_add(&s_trips, 1);
+    atomic_store(&s_next_probe, s_clock() + s_probe_ns);
+    s_dropped_at_trip = mu_log_buf_dropped() + atomic_load(&s_lost);
+    snprintf(event, sizeof(event),
+             "mu_log_brk: sink %s (%llu us), buffering", why,
+             (unsigned long long)(elapsed / 1000));
+    divert(MU_LOG_LEVEL_WARN, event);
+}
+
+/**
+ * @brief Replays the backlog into the sink, record by record, and closes
+ * the breaker if every call is quick.  Only one thread probes at a time.
+ */
+static void probe(uint64_t now) {
+    bool healthy = true;
+    char event[EVENT_MAX];
+
+    if (now < atomic_load(&s_next_probe) ||
+        atomic_flag_test_and_set(&s_probing)) {
+        return;
+    }
+    while (healthy && mu_log_buf_drain(replay_writer, &healthy, 1) == 1) {
+    }
+    if (!healthy) {
+        atomic_store(&s_next_probe, s_clock() + s_probe_ns);
+        atomic_flag_clear(&s_probing);
+        return;
+    }
+    atomic_store(&s_state, MU_LOG_BRK_CLOSED);
+    // a record diverted by a thread that still saw the breaker open waits in
+    // the ring for the next recovery
+    mu_log_buf_drain(replay_writer, &healthy, 0);
+    snprintf(event, sizeof(event),
+             "mu_log_brk: sink recovered, %zu records dropped",
+             mu_log_buf_dropped() + atomic_load(&s_lost) - s_dropped_at_trip);
+    call_sink(MU_LOG_LEVEL_INFO, event, strlen(event));
+    atomic_flag_clear(&s_probing);
+}
+
+static void replay_writer(mu_log_level_t level, const char *data, size_t len,
+                          void *arg) {
+    bool *healthy = (bool *)arg;
+    uint64_t start = s_clock();
+    int n = call_sink(level, data, len);
+
+    if (n < 0) {
+        atomic_fetch_add(&s_lost, 1); // already taken out of the ring
+    }
+    if (n < 0 || s_clock() - start > s_slow_ns) {
+        *healthy = false;
+    }
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
@@ -0,0 +1,338 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_buf.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include "mu_log_mem.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+/**
+ * Record header.  Every record starts on a REC_ALIGN boundary, so a header
+ * always fits before the end of the ring, where a padding record fills the
+ * gap when the next record would wrap.  Free space in the ring is kept zeroed
+ * (the drain clears what it consumes), so `state` reads 0 until the producer
+ * publishes the record.
+ */
+typedef struct {
+    atomic_uint state; // REC_EMPTY until committed (or written as padding)
+    uint32_t size;     // bytes occupied, header included
+    uint32_t len;      // payload bytes used
+    uint32_t level;
+} rec_t;
+
+#define REC_ALIGN sizeof(rec_t)
+#define MIN_RING_SIZE 64
+
+enum { REC_EMPTY = 0, REC_COMMITTED, REC_PADDING };
+
+typedef struct {
+    mu_log_span_t span; // span.data == NULL: no batch open
+    size_t used;        // bytes written into span.data
+} batch_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void drop(void);
+static bool batch_add(batch_t *batch, const char *line, size_t len);
+
+// *****************************************************************************
+// Private (static) storage
+
+static unsigned char *s_ring;
+static size_t s_size;
+static atomic_size_t s_head; // next byte to reserve (monotonic)
+static atomic_size_t s_tail; // next byte to drain (monotonic)
+static atomic_size_t s_dropped;
+static mu_log_clock_fn s_clock;
+static MU_LOG_BUF_THREAD_LOCAL batch_t s_batch;
+
+// *****************************************************************************
+// Public code
+
+bool mu_log_buf_init(size_t size) {
+    if (size < MIN_RING_SIZE || (size & (size - 1)) != 0) {
+        return false;
+    }
+    if (s_ring == NULL) {
+        s_ring = (unsigned char *)mu_log_alloc(size, REC_ALIGN);
+        if (s_ring == NULL) {
+            return false;
+        }
+        s_size = size;
+    } else if (size != s_size) {
+        return false;
+    }
+    memset(s_ring, 0, s_size);
+    atomic_init(&s_head, 0);
+    atomic_init(&s_tail, 0);
+    atomic_init(&s_dropped, 0);
+    return true;
+}
+
+mu_log_span_t mu_log_reserve(mu_log_level_t level, size_t max_len) {
+    mu_log_span_t span = {NULL, 0, NULL};
+    size_t need = (sizeof(rec_t) + max_len + REC_ALIGN - 1) & ~(REC_ALIGN - 1);
+    size_t head, pad;
+    rec_t *rec;
+
+    if (!mu_log_will_log(level)) {
+        return span;
+    }
+    if (s_ring == NULL || max_len > s_size / 4) {
+        drop();
+        return span;
+    }
+    head = atomic_load_explicit(&s_head, memory_order_relaxed);
+    for (;;) {
+        size_t contiguous = s_size - (head & (s_size - 1));
+        size_t tail = atomic_load_explicit(&s_tail, memory_order_acquire);
+
+        pad = need <= contiguous ? 0 : contiguous;
+        if (head + pad + need - tail > s_size) {
+            drop();
+            return span;
+        }
+        if (atomic_compare_exchange_weak_explicit(&s_head, &head,
+                                                  head + pad + need,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+    }
+    if (pad != 0) {
+        rec = (rec_t *)(s_ring + (head & (s_size - 1)));
+        rec->size = (uint32_t)pad;
+        atomic_store_explicit(&rec->state, REC_PADDING, memory_order_release);
+        head += pad;
+    }
+    rec = (rec_t *)(s_ring + (head & (s_size - 1)));
+    rec->size = (uint32_t)need;
+    rec->level = (uint32_t)level;
+    span.data = (char *)(rec + 1);
+    span.size = need - sizeof(rec_t);
+    span.record = rec;
+    return span;
+}
+
+void mu_log_commit(mu_log_span_t span, size_t used_len) {
+    rec_t *rec = (rec_t *)span.record;
+
+    if (rec == NULL) {
+        return;
+    }
+    rec->len = (uint32_t)(used_len < span.size ? used_len : span.size);
+    atomic_store_explicit(&rec->state, REC_COMMITTED, memory_order_release);
+}
+
+size_t mu_log_buf_drain(mu_log_buf_writer_fn write, void *arg,
+                        size_t max_records) {
+    size_t tail = atomic_load_explicit(&s_tail, memory_order_relaxed);
+    size_t n = 0;
+
+    while (max_records == 0 || n < max_records) {
+        size_t head = atomic_load_explicit(&s_head, memory_order_acquire);
+        rec_t *rec;
+        unsigned state;
+        uint32_t size;
+
+        if (tail == head) {
+            break;
+        }
+        rec = (rec_t *)(s_ring + (tail & (s_size - 1)));
+        state = atomic_load_explicit(&rec->state, memory_order_acquire);
+        if (state == REC_EMPTY) {
+            break; // reserved but not yet committed
+        }
+        size = rec->size;
+        if (state == REC_COMMITTED) {
+            write((mu_log_level_t)rec->level, (const char *)(rec + 1),
+                  rec->len, arg);
+            n++;
+        }
+        // return the space zeroed, then hand it back to the producers
+        memset((unsigned char *)rec + sizeof(atomic_uint), 0,
+               size - sizeof(atomic_uint));
+        atomic_store_explicit(&rec->state, REC_EMPTY, memory_order_relaxed);
+        tail += size;
+        atomic_store_explicit(&s_tail, tail, memory_order_release);
+    }
+    return n;
+}
+
+size_t mu_log_buf_dropped(void) {
+    return atomic_load_explicit(&s_dropped, memory_order_relaxed);
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_buf_fn(mu_log_level_t level, const char *format, va_list ap) {
+    mu_log_span_t span = mu_log_reserve(level, MU_LOG_BUF_LINE_MAX);
+    int n;
+
+    if (span.data == NULL) {
+        return 0;
+    }
+    // format straight into the ring; vsnprintf's NUL stays inside the span
+    n = vsnprintf(span.data, span.size, format, ap);
+    if (n < 0) {
+        n = 0;
+    } else if ((size_t)n >= span.size) {
+        n = (int)span.size - 1;
+    }
+    mu_log_commit(span, (size_t)n);
+    return n;
+}
+
+#else
+int mu_log_buf_fn(mu_log_level_t level, const char *message) {
+    size_t len = strlen(message);
+    mu_log_span_t span = mu_log_reserve(level, len);
+
+    if (span.data == NULL) {
+        return 0;
+    }
+    memcpy(span.data, message, len);
+    mu_log_commit(span, len);
+    return (int)len;
+}
+#endif
+
+void mu_log_buf_stdout_writer(mu_log_level_t level, const char *data,
+                              size_t len, void *arg) {
+    (void)arg;
+#ifdef MU_LOG_ENABLE_FORMATTED
+    printf("%5s: ", mu_log_level_name(level));
+#else
+    fputs(mu_log_level_name(level), stdout);
+    fputs(": ", stdout);
+#endif
+    fwrite(data, 1, len, stdout);
+    fputc('\n', stdout);
+}
+
+void mu_log_batch_set_clock(mu_log_clock_fn clock) {
+    s_clock = clock;
+}
+
+bool mu_log_batch_begin(mu_log_level_t level) {
+    size_t max_len = MU_LOG_BUF_BATCH_MAX;
+    char header[32];
+    int n;
+
+    if (s_batch.span.data != NULL) {
+        return false;
+    }
+    if (max_len > s_size / 4) {
+        max_len = s_size / 4;
+    }
+    s_batch.span = mu_log_reserve(level, max_len);
+    s_batch.used = 0;
+    if (s_batch.span.data == NULL) {
+        return false;
+    }
+    n = snprintf(header, sizeof(header), "batch @%llu",
+                 (unsigned long long)(s_clock != NULL ? s_clock() : 0));
+    batch_add(&s_batch, header, (size_t)n);
+    return true;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+bool mu_log_batch_append(const char *format, ...) {
+    char *line;
+    size_t avail;
+    va_list ap;
+    int n;
+
+    if (s_batch.span.data == NULL || s_batch.used + 1 >= s_batch.span.size) {
+        return false;
+    }
+    // format in place after the separating newline
+    line = s_batch.span.data + s_batch.used + 1;
+    avail = s_batch.span.size - s_batch.used - 1;
+    va_start(ap, format);
+    n = vsnprintf(line, avail, format, ap);
+    va_end(ap);
+    if (n < 0 || (size_t)n >= avail) {
+        return false;
+    }
+    line[-1] = '\n';
+    s_batch.used += (size_t)n + 1;
+    return true;
+}
+
+#else
+bool mu_log_batch_append(const char *message) {
+    if (s_batch.span.data == NULL || s_batch.used >= s_batch.span.size) {
+        return false;
+    }
+    s_batch.span.data[s_batch.used++] = '\n';
+    if (!batch_add(&s_batch, message, strlen(message))) {
+        s_batch.used--;
+        return false;
+    }
+    return true;
+}
+#endif
+
+void mu_log_batch_end(void) {
+    if (s_batch.span.data == NULL) {
+        return;
+    }
+    mu_log_commit(s_batch.span, s_batch.used);
+    s_batch.span.data = NULL;
+    s_batch.span.record = NULL;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void drop(void) {
+    atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+}
+
+static bool batch_add(batch_t *batch, const char *line, size_t len) {
+    if (len > batch->span.size - batch->used) {
+        return false;
+    }
+    memcpy(batch->span.data + batch->used, line, len);
+    batch->used += len;
+    return true;
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
@@ -0,0 +1,411 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_cfg.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include "mu_log_mem.h"
+
+#include <stdatomic.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define CACHE_LINE 64
+
+#if defined(MU_LOG_ROUTES) && MU_LOG_CFG_MAX_SINKS > 8
+#error "MU_LOG_ROUTES keeps a sink mask per level in one byte"
+#endif
+
+enum { SNAP_FREE = 0, SNAP_CURRENT, SNAP_RETIRED };
+
+typedef struct {
+    mu_log_config_t config;
+    unsigned long retired; // epoch at which it stopped being current
+    int state;             // writer side only
+} snapshot_t;
+
+/**
+ * One per registered thread, each on its own cache line.  `seen` is the last
+ * epoch at which the reader was quiescent; 0 marks a free entry.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_ulong seen;
+} reader_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void lock_writers(void);
+static void unlock_writers(void);
+static size_t reclaim_locked(void);
+static mu_log_level_t lowest_threshold(const mu_log_config_t *config);
+static bool prefix_matches(const char *rule, const char *name);
+
+// *****************************************************************************
+// Private (static) storage
+
+static snapshot_t *s_snapshots;   // from mu_log_alloc(), by mu_log_cfg_init()
+static reader_t *s_readers;       // ditto
+static _Atomic(snapshot_t *) s_current;
+static atomic_ulong s_epoch;
+static atomic_flag s_writer_lock = ATOMIC_FLAG_INIT;
+
+#ifndef MU_LOG_SHM // otherwise it lives in the control page
+// written by publishers (under the writer lock), read by MU_LOG_MODULES sites
+unsigned mu_log_module_generation;
+#endif
+
+// *****************************************************************************
+// Public code
+
+bool mu_log_cfg_init(void) {
+    static const mu_log_config_t empty = {0};
+
+    if (s_snapshots == NULL) {
+        s_snapshots = (snapshot_t *)mu_log_alloc(
+            sizeof(snapshot_t) * MU_LOG_CFG_SNAPSHOTS, _Alignof(snapshot_t));
+        s_readers = (reader_t *)mu_log_alloc(
+            sizeof(reader_t) * MU_LOG_CFG_MAX_READERS, _Alignof(reader_t));
+        if (s_snapshots == NULL || s_readers == NULL) {
+            s_snapshots = NULL;
+            return false;
+        }
+    }
+    for (int i = 0; i < MU_LOG_CFG_SNAPSHOTS; i++) {
+        s_snapshots[i].state = SNAP_FREE;
+    }
+    for (int i = 0; i < MU_LOG_CFG_MAX_READERS; i++) {
+        atomic_init(&s_readers[i].seen, 0);
+    }
+    atomic_init(&s_current, NULL);
+    atomic_init(&s_epoch, 1);
+    return mu_log_cfg_publish(&empty);
+}
+
+bool mu_log_cfg_publish(const mu_log_config_t *config) {
+    snapshot_t *next = NULL;
+    snapshot_t *prev;
+
+    if (s_snapshots == NULL || config->n_sinks > MU_LOG_CFG_MAX_SINKS ||
+        config->n_modules > MU_LOG_CFG_MAX_MODULES) {
+        return false;
+    }
+    lock_writers();
+    for (int pass = 0; next == NULL && pass < 2; pass++) {
+        for (int i = 0; i < MU_LOG_CFG_SNAPSHOTS; i++) {
+            if (s_snapshots[i].state == SNAP_FREE) {
+                next = &s_snapshots[i];
+                break;
+            }
+        }
+        if (next == NULL) {
+            reclaim_locked();
+        }
+    }
+    if (next == NULL) {
+        unlock_writers();
+        return false;
+    }
+    next->config = *config;
+    next->state = SNAP_CURRENT;
+
+    // publish, then open a new epoch: a reader that is quiescent in it has
+    // finished with `prev`
+    prev = atomic_exchange(&s_current, next);
+    if (prev != NULL) {
+        prev->retired = atomic_fetch_add(&s_epoch, 1) + 1;
+        prev->state = SNAP_RETIRED;
+    }
+    if (config->n_sinks != 0) {
+        // an empty configuration (e.g. from mu_log_cfg_init()) leaves the
+        // threshold alone, for programs that log through another sink
+        mu_log_set_threshold(lowest_threshold(config));
+    }
+    // sites that see the new generation also see the new snapshot
+    MU_LOG_STORE_RELEASE(&mu_log_module_generation,
+                         MU_LOG_LOAD_RELAXED(&mu_log_module_generation) + 1);
+    unlock_writers();
+    return true;
+}
+
+mu_log_level_t mu_log_cfg_module_threshold(const mu_log_config_t *config,
+                                           const char *name) {
+    mu_log_level_t threshold = config->module_default;
+    size_t best = 0;
+
+    for (size_t i = 0; i < config->n_modules; i++) {
+        const char *rule = config->modules[i].name;
+        size_t len = strlen(rule);
+
+        if (len > best && prefix_matches(rule, name)) {
+            threshold = config->modules[i].threshold;
+            best = len;
+        }
+    }
+    return threshold;
+}
+
+unsigned mu_log_cfg_sink_mask(const mu_log_config_t *config, const char *name,
+                              mu_log_level_t level) {
+    unsigned mask = 0;
+
+    for (size_t i = 0; i < config->n_sinks; i++) {
+        if (level >= config->sinks[i].threshold &&
+            prefix_matches(config->sinks[i].module, name)) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+#ifdef MU_LOG_ROUTES
+void mu_log_cfg_route_site(mu_log_site_t *site, mu_log_level_t threshold) {
+    const mu_log_config_t *config = mu_log_cfg_current();
+    const char *name = site->module != NULL ? site->module->name : "";
+
+    // other threads may be reading the masks; the caller publishes them by
+    // storing the site's generation afterwards
+    for (int level = MU_LOG_LEVEL_TRACE; level <= MU_LOG_LEVEL_FATAL; level++) {
+        MU_LOG_STORE_RELAXED(
+            &site->routes[level],
+            config != NULL && level >= (int)threshold
+                ? (unsigned char)mu_log_cfg_sink_mask(config, name,
+                                                      (mu_log_level_t)level)
+                : (unsigned char)0);
+    }
+}
+
+#ifndef MU_LOG_SHM // otherwise mu_log_shm.c also lists the site
+void mu_log_site_resolve(mu_log_site_t *site) {
+    unsigned generation = MU_LOG_LOAD_ACQUIRE(&mu_log_module_generation);
+    const mu_log_config_t *config = mu_log_cfg_current();
+
+    mu_log_cfg_route_site(
+        site, config != NULL && site->module != NULL
+                  ? mu_log_cfg_module_threshold(config, site->module->name)
+                  : MU_LOG_LEVEL_TRACE);
+    // publish after the routes; a stale generation only causes another
+    // refresh
+    MU_LOG_STORE_RELEASE(&site->generation, generation);
+}
+#endif
+#endif
+
+void mu_log_module_resolve(mu_log_module_t *module) {
+    unsigned generation = MU_LOG_LOAD_ACQUIRE(&mu_log_module_generation);
+    const mu_log_config_t *config = mu_log_cfg_current();
+
+    MU_LOG_STORE_RELAXED(&module->threshold,
+                         config != NULL
+                             ? mu_log_cfg_module_threshold(config, module->name)
+                             : MU_LOG_LEVEL_TRACE);
+    // publish after the threshold; a stale generation only causes another
+    // lookup
+    MU_LOG_STORE_RELEASE(&module->generation, generation);
+}
+
+const mu_log_config_t *mu_log_cfg_current(void) {
+    snapshot_t *snap = atomic_load_explicit(&s_current, memory_order_acquire);
+    return snap != NULL ? &snap->config : NULL;
+}
+
+int mu_log_cfg_register_reader(void) {
+    for (int i = 0; s_readers != NULL && i < MU_LOG_CFG_MAX_READERS; i++) {
+        unsigned long expected = 0;
+        if (atomic_compare_exchange_strong(&s_readers[i].seen, &expected,
+                                           atomic_load(&s_epoch))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void mu_log_cfg_unregister_reader(int reader) {
+    if (reader >= 0 && reader < MU_LOG_CFG_MAX_READERS) {
+        atomic_store_explicit(&s_readers[reader].seen, 0, memory_order_release);
+    }
+}
+
+void mu_log_cfg_quiescent(int reader) {
+    unsigned long epoch = atomic_load_explicit(&s_epoch, memory_order_acquire);
+
+    if (reader >= 0 && reader < MU_LOG_CFG_MAX_READERS) {
+        atomic_store_explicit(&s_readers[reader].seen, epoch,
+                              memory_order_release);
+    }
+}
+
+size_t mu_log_cfg_reclaim(void) {
+    size_t n;
+
+    if (s_snapshots == NULL) {
+        return 0;
+    }
+    lock_writers();
+    n = reclaim_locked();
+    unlock_writers();
+    return n;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_cfg_fn(mu_log_level_t level, const char *format, va_list ap) {
+    const mu_log_config_t *config = mu_log_cfg_current();
+    int n = 0;
+
+    for (size_t i = 0; config != NULL && i < config->n_sinks; i++) {
+        if (level >= config->sinks[i].threshold &&
+            config->sinks[i].module[0] == '\0') {
+            va_list aq;
+            va_copy(aq, ap);
+            n += config->sinks[i].fn(level, format, aq);
+            va_end(aq);
+        }
+    }
+    return n;
+}
+
+#ifdef MU_LOG_ROUTES
+void mu_log_routed(unsigned routes, mu_log_level_t level, const char *format,
+                   ...) {
+    const mu_log_config_t *config = mu_log_cfg_current();
+
+    // routes resolved from an older snapshot: at worst one record reaches
+    // the sink now at that index
+    for (size_t i = 0; config != NULL && i < config->n_sinks; i++) {
+        if (routes & (1u << i)) {
+            va_list ap;
+            va_start(ap, format);
+            config->sinks[i].fn(level, format, ap);
+            va_end(ap);
+        }
+    }
+}
+#endif
+
+#else
+int mu_log_cfg_fn(mu_log_level_t level, const char *message) {
+    const mu_log_config_t *config = mu_log_cfg_current();
+    int n = 0;
+
+    for (size_t i = 0; config != NULL && i < config->n_sinks; i++) {
+        if (level >= config->sinks[i].threshold &&
+            config->sinks[i].module[0] == '\0') {
+            n += config->sinks[i].fn(level, message);
+        }
+    }
+    return n;
+}
+
+#ifdef MU_LOG_ROUTES
+void mu_log_routed(unsigned routes, mu_log_level_t level, const char *message) {
+    const mu_log_config_t *config = mu_log_cfg_current();
+
+    // routes resolved from an older snapshot: at worst one record reaches
+    // the sink now at that index
+    for (size_t i = 0; config != NULL && i < config->n_sinks; i++) {
+        if (routes & (1u << i)) {
+            config->sinks[i].fn(level, message);
+        }
+    }
+}
+#endif
+#endif
+
+// *****************************************************************************
+// Private (static) code
+
+static void lock_writers(void) {
+    while (atomic_flag_test_and_set_explicit(&s_writer_lock,
+                                             memory_order_acquire)) {
+        // publishers only; readers never wait here
+    }
+}
+
+static void unlock_writers(void) {
+    atomic_flag_clear_explicit(&s_writer_lock, memory_order_release);
+}
+
+static size_t reclaim_locked(void) {
+    unsigned long oldest = ULONG_MAX;
+    size_t n = 0;
+
+    // the oldest epoch any registered reader may still be in
+    for (int i = 0; i < MU_LOG_CFG_MAX_READERS; i++) {
+        unsigned long seen =
+            atomic_load_explicit(&s_readers[i].seen, memory_order_acquire);
+        if (seen != 0 && seen < oldest) {
+            oldest = seen;
+        }
+    }
+    for (int i = 0; i < MU_LOG_CFG_SNAPSHOTS; i++) {
+        if (s_snapshots[i].state == SNAP_RETIRED &&
+            s_snapshots[i].retired <= oldest) {
+            s_snapshots[i].state = SNAP_FREE;
+            n++;
+        }
+    }
+    return n;
+}
+
+static mu_log_level_t lowest_threshold(const mu_log_config_t *config) {
+    int sinks = MU_LOG_LEVEL_FATAL;
+    int modules = (int)config->module_default;
+
+    for (size_t i = 0; i < config->n_sinks; i++) {
+        if ((int)config->sinks[i].threshold < sinks) {
+            sinks = (int)config->sinks[i].threshold;
+        }
+    }
+    for (size_t i = 0; i < config->n_modules; i++) {
+        if ((int)config->modules[i].threshold < modules) {
+            modules = (int)config->modules[i].threshold;
+        }
+    }
+    // a record must pass both a module's and a sink's threshold
+    return (mu_log_level_t)(sinks > modules ? sinks : modules);
+}
+
+/**
+ * @brief True if `rule` names module `name` or one of its parents; the empty
+ * rule names every module.
+ */
+static bool prefix_matches(const char *rule, const char *name) {
+    size_t len = strlen(rule);
+
+    return strncmp(name, rule, len) == 0 &&
+           (len == 0 || name[len] == '\0' || name[len] == '.');
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
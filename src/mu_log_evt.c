@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_evt.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void signal_loop(void);
+
+// *****************************************************************************
+// Private (static) storage
+
+static int s_fd = -1;
+static mu_log_buf_writer_fn s_write;
+static void *s_arg;
+static atomic_bool s_pending; // set from the first notify until the drain
+
+// *****************************************************************************
+// Public code
+
+int mu_log_evt_init(mu_log_buf_writer_fn write, void *arg) {
+    mu_log_evt_close();
+    s_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    s_write = write;
+    s_arg = arg;
+    atomic_init(&s_pending, false);
+    return s_fd;
+}
+
+void mu_log_evt_close(void) {
+    if (s_fd >= 0) {
+        close(s_fd);
+        s_fd = -1;
+    }
+}
+
+void mu_log_evt_notify(void) {
+    // only the notify that finds the flag clear pays for the system call
+    if (!atomic_exchange(&s_pending, true)) {
+        signal_loop();
+    }
+}
+
+size_t mu_log_evt_drain(size_t budget) {
+    uint64_t count;
+    size_t n;
+
+    if (s_fd < 0) {
+        return 0;
+    }
+    // reset the descriptor and clear the flag before looking at the ring: a
+    // record committed after the drain passes it signals again
+    if (read(s_fd, &count, sizeof(count)) < 0) {
+        // EAGAIN: drained without a signal, e.g. from a timer
+    }
+    atomic_store(&s_pending, false);
+    n = mu_log_buf_drain(s_write, s_arg, budget);
+    if (budget != 0 && n == budget) {
+        // possibly more: come back on the next loop iteration
+        mu_log_evt_notify();
+    }
+    return n;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_evt_fn(mu_log_level_t level, const char *format, va_list ap) {
+    int n = mu_log_buf_fn(level, format, ap);
+    mu_log_evt_notify();
+    return n;
+}
+
+#else
+int mu_log_evt_fn(mu_log_level_t level, const char *message) {
+    int n = mu_log_buf_fn(level, message);
+    mu_log_evt_notify();
+    return n;
+}
+#endif
+
+// *****************************************************************************
+// Private (static) code
+
+static void signal_loop(void) {
+    uint64_t one = 1;
+
+    if (s_fd >= 0 && write(s_fd, &one, sizeof(one)) < 0) {
+        // the counter is saturated: the loop is already signaled
+    }
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
@@ -0,0 +1,300 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_fc.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include "mu_log_mem.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/uio.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SLOT_ALIGN 64 // one slot per cache line, at least
+#define SPINS_BEFORE_YIELD 64
+
+_Static_assert(MU_LOG_FC_SLOTS <= 1024, "MU_LOG_FC_SLOTS exceeds IOV_MAX");
+
+/**
+ * A publication slot.  Its owner claims it (FREE -> CLAIMED), renders the
+ * line and publishes it (READY); the combiner writes it and reports the
+ * outcome (DONE or FAILED); the owner reads the outcome and frees it.
+ */
+typedef struct {
+    _Alignas(SLOT_ALIGN) atomic_uint state;
+    uint32_t len;
+    char line[MU_LOG_FC_LINE_MAX];
+} slot_t;
+
+enum { SLOT_FREE = 0, SLOT_CLAIMED, SLOT_READY, SLOT_DONE, SLOT_FAILED };
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static slot_t *claim_slot(void);
+static unsigned publish(slot_t *slot);
+static bool try_combine(void);
+static void combine(void);
+static bool write_all(struct iovec *iov, int n);
+static void backoff(unsigned spins);
+static size_t header(char *line, mu_log_level_t level);
+
+// *****************************************************************************
+// Private (static) storage
+
+static slot_t *s_slots;
+static int s_fd = -1;
+static atomic_flag s_combiner = ATOMIC_FLAG_INIT;
+static atomic_size_t s_lines;
+static atomic_size_t s_writes;
+static MU_LOG_FC_THREAD_LOCAL unsigned s_hint; // slot this thread used last
+
+// *****************************************************************************
+// Public code
+
+bool mu_log_fc_init(int fd) {
+    if (s_slots == NULL) {
+        s_slots = (slot_t *)mu_log_alloc(sizeof(slot_t) * MU_LOG_FC_SLOTS,
+                                         SLOT_ALIGN);
+        if (s_slots == NULL) {
+            return false;
+        }
+        memset(s_slots, 0, sizeof(slot_t) * MU_LOG_FC_SLOTS);
+    }
+    s_fd = fd;
+    atomic_store(&s_lines, 0);
+    atomic_store(&s_writes, 0);
+    return true;
+}
+
+void mu_log_fc_stats(size_t *lines, size_t *writes) {
+    *lines = atomic_load_explicit(&s_lines, memory_order_relaxed);
+    *writes = atomic_load_explicit(&s_writes, memory_order_relaxed);
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_fc_fn(mu_log_level_t level, const char *format, va_list ap) {
+    slot_t *slot;
+    size_t len;
+    int n;
+
+    if (!mu_log_will_log(level) || s_slots == NULL) {
+        return 0;
+    }
+    slot = claim_slot();
+    len = header(slot->line, level);
+    // the newline replaces vsnprintf's NUL; a long line is truncated
+    n = vsnprintf(&slot->line[len], MU_LOG_FC_LINE_MAX - len, format, ap);
+    if (n > 0) {
+        len += (size_t)n < MU_LOG_FC_LINE_MAX - len
+                   ? (size_t)n
+                   : MU_LOG_FC_LINE_MAX - 1 - len;
+    }
+    slot->line[len++] = '\n';
+    slot->len = (uint32_t)len;
+    return publish(slot) == SLOT_DONE ? (int)len : -1;
+}
+
+#else
+int mu_log_fc_fn(mu_log_level_t level, const char *message) {
+    slot_t *slot;
+    size_t len;
+    size_t n;
+
+    if (!mu_log_will_log(level) || s_slots == NULL) {
+        return 0;
+    }
+    slot = claim_slot();
+    len = header(slot->line, level);
+    n = strlen(message);
+    if (n > MU_LOG_FC_LINE_MAX - 1 - len) {
+        n = MU_LOG_FC_LINE_MAX - 1 - len; // a long line is truncated
+    }
+    memcpy(&slot->line[len], message, n);
+    len += n;
+    slot->line[len++] = '\n';
+    slot->len = (uint32_t)len;
+    return publish(slot) == SLOT_DONE ? (int)len : -1;
+}
+#endif
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Claims a free slot, starting with the one this thread used last.
+ *
+ * When every slot is taken, helps write them out until one frees up.
+ */
+static slot_t *claim_slot(void) {
+    for (unsigned spins = 0;; spins++) {
+        for (unsigned i = 0; i < MU_LOG_FC_SLOTS; i++) {
+            unsigned index = (s_hint + i) % MU_LOG_FC_SLOTS;
+            unsigned expected = SLOT_FREE;
+
+            if (atomic_compare_exchange_strong_explicit(
+                    &s_slots[index].state, &expected, SLOT_CLAIMED,
+                    memory_order_acquire, memory_order_relaxed)) {
+                s_hint = index;
+                return &s_slots[index];
+            }
+        }
+        if (!try_combine()) {
+            backoff(spins);
+        }
+    }
+}
+
+/**
+ * @brief Publishes a rendered line and returns once it has been written,
+ * combining if no other thread is.
+ *
+ * @return SLOT_DONE or SLOT_FAILED.
+ */
+static unsigned publish(slot_t *slot) {
+    unsigned state;
+
+    atomic_store_explicit(&slot->state, SLOT_READY, memory_order_release);
+    for (unsigned spins = 0;; spins++) {
+        state = atomic_load_explicit(&slot->state, memory_order_acquire);
+        if (state == SLOT_DONE || state == SLOT_FAILED) {
+            break;
+        }
+        if (!try_combine()) {
+            backoff(spins);
+        }
+    }
+    atomic_store_explicit(&slot->state, SLOT_FREE, memory_order_release);
+    return state;
+}
+
+/**
+ * @brief Writes the published lines if no other thread is doing so.
+ *
+ * @return `true` if this thread was the combiner.
+ */
+static bool try_combine(void) {
+    if (atomic_flag_test_and_set_explicit(&s_combiner, memory_order_acquire)) {
+        return false;
+    }
+    combine();
+    atomic_flag_clear_explicit(&s_combiner, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Writes every published line with one `writev()`.  Combiner only.
+ */
+static void combine(void) {
+    struct iovec iov[MU_LOG_FC_SLOTS];
+    slot_t *ready[MU_LOG_FC_SLOTS];
+    unsigned outcome;
+    int n = 0;
+
+    for (unsigned i = 0; i < MU_LOG_FC_SLOTS; i++) {
+        if (atomic_load_explicit(&s_slots[i].state, memory_order_acquire) ==
+            SLOT_READY) {
+            iov[n].iov_base = s_slots[i].line;
+            iov[n].iov_len = s_slots[i].len;
+            ready[n++] = &s_slots[i];
+        }
+    }
+    if (n == 0) {
+        return;
+    }
+    outcome = write_all(iov, n) ? SLOT_DONE : SLOT_FAILED;
+    if (outcome == SLOT_DONE) {
+        atomic_fetch_add_explicit(&s_lines, (size_t)n, memory_order_relaxed);
+        atomic_fetch_add_explicit(&s_writes, 1, memory_order_relaxed);
+    }
+    for (int i = 0; i < n; i++) {
+        atomic_store_explicit(&ready[i]->state, outcome, memory_order_release);
+    }
+}
+
+/**
+ * @brief Writes all of `iov`, resuming after partial writes.
+ */
+static bool write_all(struct iovec *iov, int n) {
+    while (n > 0) {
+        ssize_t written = writev(s_fd, iov, n);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        while (n > 0 && (size_t)written >= iov->iov_len) {
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+    return true;
+}
+
+static void backoff(unsigned spins) {
+    if (spins >= SPINS_BEFORE_YIELD) {
+        sched_yield(); // the combiner may be waiting for the CPU
+    }
+}
+
+/**
+ * @brief Writes the `LEVEL: ` prefix, as `mu_log_stdout_fn` does.
+ */
+static size_t header(char *line, mu_log_level_t level) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    return (size_t)snprintf(line, MU_LOG_FC_LINE_MAX, "%5s: ",
+                            mu_log_level_name(level));
+#else
+    const char *name = mu_log_level_name(level);
+    size_t len = strlen(name);
+
+    memcpy(line, name, len);
+    line[len++] = ':';
+    line[len++] = ' ';
+    return len;
+#endif
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
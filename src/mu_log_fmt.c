@@ -0,0 +1,984 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_fmt.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include <stdint.h>
+#include <string.h>
+
+#if MU_LOG_FMT_PLANS > 0
+#include <stdatomic.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DIGITS_MAX 24 // enough for a 64-bit value in decimal or hex
+#define FIELD_MAX INT16_MAX // widths and precisions are clamped to this
+
+#if MU_LOG_FMT_PLANS > 0
+#if (MU_LOG_FMT_PLANS & (MU_LOG_FMT_PLANS - 1)) != 0
+#error "MU_LOG_FMT_PLANS must be a power of two"
+#endif
+#define PLAN_SLOTS (2 * MU_LOG_FMT_PLANS) // open addressing, at most half full
+#define PLAN_MASK (PLAN_SLOTS - 1)
+#endif
+
+typedef struct {
+    mu_log_putc_hook putc;
+    void *arg;
+    int count;
+} out_t;
+
+/**
+ * Argument source: either a va_list, or an array of machine words (deferred
+ * records captured by mu_log_isr).
+ */
+typedef struct {
+    va_list ap;
+    const uintptr_t *words;
+    size_t n_words;
+    size_t next;
+} args_t;
+
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t len;
+} buf_out_t;
+
+enum {
+    FLAG_LEFT = 1,
+    FLAG_ZERO = 2,
+    FLAG_WIDTH_ARG = 4, // width is `*`
+    FLAG_PREC_ARG = 8,  // precision is `*`
+};
+
+enum {
+    OP_LITERAL = 0, // a run of text
+    OP_ECHO = 1,    // an unsupported or truncated specifier, output verbatim
+    OP_FLOAT = 2,   // a floating-point specifier: echoed, argument skipped
+    // otherwise the conversion character, or '{' for %{name}
+};
+
+/**
+ * One step of a format: a literal run or a parsed conversion.  `offset` is
+ * relative to the format (or, while streaming, to the step itself).
+ */
+typedef struct {
+    uint32_t offset;
+    uint32_t len;
+    char conv;
+    uint8_t flags;
+    uint8_t length;
+    int16_t width;
+    int16_t precision; // -1: none
+} op_t;
+
+#if MU_LOG_FMT_PLANS > 0
+/**
+ * A format parsed once: its steps, replayed against each call's arguments.
+ */
+typedef struct {
+    const char *format;
+    size_t n_ops;
+    op_t ops[MU_LOG_FMT_PLAN_OPS];
+} plan_t;
+#endif
+
+typedef struct {
+    const char *name;
+    mu_log_fmt_conv_fn conv;
+} conv_t;
+
+// Longest built-in conversion: an uncompressed IPv6 address
+#define BUILTIN_TEXT_MAX 40
+
+enum {
+    LEN_CHAR,
+    LEN_SHORT,
+    LEN_INT,
+    LEN_LONG,
+    LEN_LLONG,
+    LEN_SIZE,
+    LEN_LDOUBLE, // `L`: long double
+};
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void emit(out_t *out, char ch);
+static void emit_padded(out_t *out, const char *s, int len, int width,
+                        int flags);
+static void emit_unsigned(out_t *out, uintmax_t value, const char *prefix,
+                          unsigned base, bool upper, int width, int flags);
+static int render(out_t *out, args_t *args, const char *format);
+static const char *parse_op(const char *base, const char *p, op_t *op);
+static void exec_op(out_t *out, args_t *args, const char *base,
+                    const op_t *op);
+static int parse_field(const char **p);
+#if MU_LOG_FMT_PLANS > 0
+static const plan_t *plan_find(const char *format);
+static bool plan_build(plan_t *plan, const char *format);
+static void plan_publish(const plan_t *plan);
+static size_t plan_hash(const char *format);
+#endif
+static uintptr_t fetch_word(args_t *args);
+static int fetch_int(args_t *args);
+static uintmax_t fetch_unsigned(args_t *args, int length);
+static intmax_t fetch_signed(args_t *args, int length);
+static void skip_double(args_t *args, int length);
+static void buf_putc(char ch, void *arg);
+static void emit_string(out_t *out, const char *s);
+static void emit_run(out_t *out, const char *s, size_t len);
+#if MU_LOG_FMT_MAX_CONVS > 0
+static void render_conv(out_t *out, args_t *args, const char *spec,
+                        size_t len, int width, int flags);
+#endif
+static size_t put_hex(char *buf, uint32_t value, int digits);
+static size_t put_decimal(char *buf, uintmax_t value);
+static size_t put_clipped(char *buf, size_t size, const char *text,
+                          size_t len);
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_log_putc_hook s_putc = NULL;
+static void *s_putc_arg = NULL;
+#if MU_LOG_FMT_MAX_CONVS > 0
+static conv_t s_convs[MU_LOG_FMT_MAX_CONVS];
+static size_t s_n_convs;
+#endif
+#if MU_LOG_FMT_PLANS > 0
+static plan_t s_plans[MU_LOG_FMT_PLANS];
+static atomic_size_t s_n_plans;
+static const plan_t *_Atomic s_plan_slots[PLAN_SLOTS];
+static atomic_size_t s_plan_hits;
+static atomic_size_t s_plan_misses;
+#endif
+
+// *****************************************************************************
+// Public code
+
+int mu_log_fmt_vformat(mu_log_putc_hook putc, void *arg, const char *format,
+                       va_list ap) {
+    out_t out = {.putc = putc, .arg = arg, .count = 0};
+    args_t args = {.words = NULL};
+    int n;
+
+    va_copy(args.ap, ap);
+    n = render(&out, &args, format);
+    va_end(args.ap);
+    return n;
+}
+
+int mu_log_fmt_wformat(mu_log_putc_hook putc, void *arg, const char *format,
+                       const uintptr_t *words, size_t n_words) {
+    out_t out = {.putc = putc, .arg = arg, .count = 0};
+    args_t args = {.words = words, .n_words = n_words, .next = 0};
+
+    return render(&out, &args, format);
+}
+
+int mu_log_fmt_vsnprintf(char *buf, size_t size, const char *format,
+                         va_list ap) {
+    buf_out_t out = {.buf = buf, .size = size, .len = 0};
+    int n = mu_log_fmt_vformat(buf_putc, &out, format, ap);
+
+    if (size > 0) {
+        buf[out.len < size ? out.len : size - 1] = '\0';
+    }
+    return n;
+}
+
+int mu_log_fmt_wsnprintf(char *buf, size_t size, const char *format,
+                         const uintptr_t *words, size_t n_words) {
+    buf_out_t out = {.buf = buf, .size = size, .len = 0};
+    int n = mu_log_fmt_wformat(buf_putc, &out, format, words, n_words);
+
+    if (size > 0) {
+        buf[out.len < size ? out.len : size - 1] = '\0';
+    }
+    return n;
+}
+
+int mu_log_fmt_snprintf(char *buf, size_t size, const char *format, ...) {
+    va_list ap;
+    int n;
+
+    va_start(ap, format);
+    n = mu_log_fmt_vsnprintf(buf, size, format, ap);
+    va_end(ap);
+    return n;
+}
+
+bool mu_log_fmt_register(const char *name, mu_log_fmt_conv_fn conv) {
+#if MU_LOG_FMT_MAX_CONVS > 0
+    size_t i;
+
+    for (i = 0; i < s_n_convs; i++) {
+        if (strcmp(s_convs[i].name, name) == 0) {
+            break;
+        }
+    }
+    if (i == MU_LOG_FMT_MAX_CONVS) {
+        return false;
+    }
+    s_convs[i].name = name;
+    s_convs[i].conv = conv;
+    if (i == s_n_convs) {
+        s_n_convs++;
+    }
+    return true;
+#else
+    (void)name;
+    (void)conv;
+    return false;
+#endif
+}
+
+bool mu_log_fmt_register_builtins(void) {
+    return mu_log_fmt_register("ipv4", mu_log_fmt_ipv4) &&
+           mu_log_fmt_register("ipv6", mu_log_fmt_ipv6) &&
+           mu_log_fmt_register("uuid", mu_log_fmt_uuid) &&
+           mu_log_fmt_register("dur_ns", mu_log_fmt_dur_ns);
+}
+
+size_t mu_log_fmt_ipv4(char *buf, size_t size, uintptr_t value) {
+    char text[BUILTIN_TEXT_MAX];
+    size_t len = 0;
+
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        len += put_decimal(&text[len], (value >> shift) & 0xffu);
+        if (shift != 0) {
+            text[len++] = '.';
+        }
+    }
+    return put_clipped(buf, size, text, len);
+}
+
+size_t mu_log_fmt_ipv6(char *buf, size_t size, uintptr_t value) {
+    const uint8_t *addr = (const uint8_t *)value;
+    uint32_t groups[8];
+    int run_start = -1;
+    int run_len = 1; // RFC 5952: a single zero group is not compressed
+    char text[BUILTIN_TEXT_MAX];
+    size_t len = 0;
+
+    for (int i = 0; i < 8; i++) {
+        groups[i] = ((uint32_t)addr[2 * i] << 8) | addr[2 * i + 1];
+    }
+    for (int i = 0; i < 8; i++) {
+        int j = i;
+        while (j < 8 && groups[j] == 0) {
+            j++;
+        }
+        if (j - i > run_len) {
+            run_start = i;
+            run_len = j - i;
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        if (i == run_start) {
+            text[len++] = ':';
+            if (i == 0) {
+                text[len++] = ':';
+            }
+            i += run_len - 1;
+            continue;
+        }
+        len += put_hex(&text[len], groups[i], 0);
+        if (i != 7) {
+            text[len++] = ':';
+        }
+    }
+    return put_clipped(buf, size, text, len);
+}
+
+size_t mu_log_fmt_uuid(char *buf, size_t size, uintptr_t value) {
+    const uint8_t *uuid = (const uint8_t *)value;
+    char text[BUILTIN_TEXT_MAX];
+    size_t len = 0;
+
+    for (int i = 0; i < 16; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            text[len++] = '-';
+        }
+        len += put_hex(&text[len], uuid[i], 2);
+    }
+    return put_clipped(buf, size, text, len);
+}
+
+size_t mu_log_fmt_dur_ns(char *buf, size_t size, uintptr_t value) {
+    static const char *const units[] = {"ns", "us", "ms", "s"};
+    uintmax_t scaled = value;
+    uintmax_t fraction = 0;
+    int unit = 0;
+    char text[BUILTIN_TEXT_MAX];
+    size_t len;
+
+    while (scaled >= 1000 && unit < 3) {
+        fraction = scaled % 1000;
+        scaled /= 1000;
+        unit++;
+    }
+    len = put_decimal(text, scaled);
+    if (unit != 0) {
+        text[len++] = '.';
+        text[len++] = (char)('0' + fraction / 100);
+        text[len++] = (char)('0' + fraction / 10 % 10);
+        text[len++] = (char)('0' + fraction % 10);
+    }
+    for (const char *u = units[unit]; *u != '\0'; u++) {
+        text[len++] = *u;
+    }
+    return put_clipped(buf, size, text, len);
+}
+
+void mu_log_fmt_plan_stats(size_t *hits, size_t *misses) {
+#if MU_LOG_FMT_PLANS > 0
+    *hits = atomic_load_explicit(&s_plan_hits, memory_order_relaxed);
+    *misses = atomic_load_explicit(&s_plan_misses, memory_order_relaxed);
+#else
+    *hits = 0;
+    *misses = 0;
+#endif
+}
+
+void mu_log_set_putc(mu_log_putc_hook putc, void *arg) {
+    s_putc = putc;
+    s_putc_arg = arg;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int mu_log_putc_fn(mu_log_level_t level, const char *format, va_list ap) {
+    out_t out = {.putc = s_putc, .arg = s_putc_arg, .count = 0};
+    const char *name = mu_log_level_name(level);
+    int len = 0;
+
+    if (!mu_log_will_log(level) || s_putc == NULL) {
+        return 0;
+    }
+    while (name[len] != '\0') {
+        len++;
+    }
+    emit_padded(&out, name, len, 5, 0); // matches "%5s: " in mu_log_stdout_fn
+    emit_string(&out, ": ");
+    out.count += mu_log_fmt_vformat(s_putc, s_putc_arg, format, ap);
+    emit(&out, '\n');
+    return out.count;
+}
+
+#else
+int mu_log_putc_fn(mu_log_level_t level, const char *message) {
+    out_t out = {.putc = s_putc, .arg = s_putc_arg, .count = 0};
+
+    if (!mu_log_will_log(level) || s_putc == NULL) {
+        return 0;
+    }
+    emit_string(&out, mu_log_level_name(level));
+    emit_string(&out, ": ");
+    emit_string(&out, message);
+    emit(&out, '\n');
+    return out.count;
+}
+#endif
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief The formatter proper, shared by the va_list and word entry points.
+ *
+ * With the plan cache, a format seen before replays its parsed steps, and a
+ * new one is parsed once and published.  Without it, or when the format has
+ * too many steps to cache, each step is parsed and executed in turn.
+ */
+static int render(out_t *out, args_t *args, const char *format) {
+    const char *p = format;
+    op_t op;
+
+#if MU_LOG_FMT_PLANS > 0
+    const plan_t *plan = plan_find(format);
+    plan_t built;
+
+    if (plan != NULL) {
+        atomic_fetch_add_explicit(&s_plan_hits, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&s_plan_misses, 1, memory_order_relaxed);
+        if (plan_build(&built, format)) {
+            plan_publish(&built);
+            plan = &built;
+        }
+    }
+    if (plan != NULL) {
+        for (size_t i = 0; i < plan->n_ops; i++) {
+            exec_op(out, args, format, &plan->ops[i]);
+        }
+        return out->count;
+    }
+#endif
+
+    while (*p != '\0') {
+        const char *next = parse_op(p, p, &op);
+        exec_op(out, args, p, &op);
+        p = next;
+    }
+    return out->count;
+}
+
+/**
+ * @brief Parses the step starting at `p`.
+ *
+ * @return Where the next step starts.
+ */
+static const char *parse_op(const char *base, const char *p, op_t *op) {
+    const char *spec = p;
+    int precision = -1;
+
+    op->offset = (uint32_t)(p - base);
+    op->flags = 0;
+    op->length = LEN_INT;
+    op->width = 0;
+    if (*p != '%') {
+        while (*p != '\0' && *p != '%') {
+            p++;
+        }
+        op->conv = OP_LITERAL;
+        op->len = (uint32_t)(p - spec);
+        return p;
+    }
+    p++;
+
+    // flags
+    for (;; p++) {
+        if (*p == '-') {
+            op->flags |= FLAG_LEFT;
+        } else if (*p == '0') {
+            op->flags |= FLAG_ZERO;
+        } else {
+            break;
+        }
+    }
+
+    // width
+    if (*p == '*') {
+        op->flags |= FLAG_WIDTH_ARG;
+        p++;
+    } else {
+        op->width = (int16_t)parse_field(&p);
+    }
+
+    // precision (honored for %s only)
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            op->flags |= FLAG_PREC_ARG;
+            p++;
+        } else {
+            precision = parse_field(&p);
+        }
+    }
+    op->precision = (int16_t)precision;
+
+    // length modifier
+    if (*p == 'h') {
+        if (p[1] == 'h') {
+            op->length = LEN_CHAR;
+            p += 2;
+        } else {
+            op->length = LEN_SHORT;
+            p++;
+        }
+    } else if (*p == 'l') {
+        if (p[1] == 'l') {
+            op->length = LEN_LLONG;
+            p += 2;
+        } else {
+            op->length = LEN_LONG;
+            p++;
+        }
+    } else if (*p == 'z') {
+        op->length = LEN_SIZE;
+        p++;
+    } else if (*p == 'L') {
+        op->length = LEN_LDOUBLE;
+        p++;
+    }
+
+    switch (*p) {
+#if MU_LOG_FMT_MAX_CONVS > 0
+    case '{': {
+        const char *end = strchr(p, '}');
+        op->conv = end != NULL ? '{' : OP_ECHO; // unterminated: echo the rest
+        p = end != NULL ? end + 1 : p + strlen(p);
+        break;
+    }
+#endif
+    default:
+        if (*p == '\0') {
+            op->conv = OP_ECHO; // truncated
+        } else if (strchr("fFeEgGaA", *p) != NULL) {
+            op->conv = OP_FLOAT;
+            p++;
+        } else {
+            op->conv = strchr("diuxXpcs%", *p) != NULL ? *p : OP_ECHO;
+            p++;
+        }
+        break;
+    }
+    op->len = (uint32_t)(p - spec);
+    return p;
+}
+
+/**
+ * @brief Executes one parsed step against the next arguments.
+ */
+static void exec_op(out_t *out, args_t *args, const char *base,
+                    const op_t *op) {
+    const char *text = base + op->offset;
+    int flags = op->flags;
+    int width = op->width;
+    int precision = op->precision;
+
+    if (op->conv == OP_LITERAL) {
+        emit_run(out, text, op->len);
+        return;
+    }
+    if (flags & FLAG_WIDTH_ARG) {
+        width = fetch_int(args);
+        if (width < 0) {
+            flags |= FLAG_LEFT;
+            width = -width;
+        }
+    }
+    if (flags & FLAG_PREC_ARG) {
+        precision = fetch_int(args);
+    }
+
+    switch (op->conv) {
+    case 'd':
+    case 'i': {
+        intmax_t value = fetch_signed(args, op->length);
+        uintmax_t magnitude =
+            value < 0 ? (uintmax_t)0 - (uintmax_t)value : (uintmax_t)value;
+        emit_unsigned(out, magnitude, value < 0 ? "-" : "", 10, false, width,
+                      flags);
+        break;
+    }
+    case 'u':
+        emit_unsigned(out, fetch_unsigned(args, op->length), "", 10, false,
+                      width, flags);
+        break;
+    case 'x':
+    case 'X':
+        emit_unsigned(out, fetch_unsigned(args, op->length), "", 16,
+                      op->conv == 'X', width, flags);
+        break;
+    case 'p':
+        emit_unsigned(out, fetch_word(args), "0x", 16, false, width, flags);
+        break;
+    case 'c': {
+        char ch = (char)fetch_int(args);
+        emit_padded(out, &ch, 1, width, flags & ~FLAG_ZERO);
+        break;
+    }
+    case 's': {
+        const char *s = (const char *)fetch_word(args);
+        int len = 0;
+        if (s == NULL) {
+            s = "(null)";
+        }
+        while (s[len] != '\0' && (precision < 0 || len < precision)) {
+            len++;
+        }
+        emit_padded(out, s, len, width, flags & ~FLAG_ZERO);
+        break;
+    }
+    case '%':
+        emit(out, '%');
+        break;
+#if MU_LOG_FMT_MAX_CONVS > 0
+    case '{':
+        render_conv(out, args, text, op->len, width, flags);
+        break;
+#endif
+    case OP_FLOAT:
+        skip_double(args, op->length);
+        emit_run(out, text, op->len);
+        break;
+    default:
+        emit_run(out, text, op->len);
+        break;
+    }
+}
+
+/**
+ * @brief Parses a decimal width or precision, clamped to FIELD_MAX.
+ */
+static int parse_field(const char **p) {
+    int value = 0;
+
+    while (**p >= '0' && **p <= '9') {
+        value = value * 10 + (*(*p)++ - '0');
+        if (value > FIELD_MAX) {
+            value = FIELD_MAX;
+        }
+    }
+    return value;
+}
+
+#if MU_LOG_FMT_PLANS > 0
+static const plan_t *plan_find(const char *format) {
+    size_t slot = plan_hash(format);
+
+    for (size_t n = 0; n < PLAN_SLOTS; n++) {
+        const plan_t *plan =
+            atomic_load_explicit(&s_plan_slots[slot], memory_order_acquire);
+        if (plan == NULL || plan->format == format) {
+            return plan;
+        }
+        slot = (slot + 1) & PLAN_MASK;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parses a whole format.
+ *
+ * @return `false` if it has more than MU_LOG_FMT_PLAN_OPS steps.
+ */
+static bool plan_build(plan_t *plan, const char *format) {
+    const char *p = format;
+
+    plan->format = format;
+    plan->n_ops = 0;
+    while (*p != '\0') {
+        if (plan->n_ops == MU_LOG_FMT_PLAN_OPS) {
+            return false;
+        }
+        p = parse_op(format, p, &plan->ops[plan->n_ops++]);
+    }
+    return true;
+}
+
+/**
+ * @brief Copies a plan into the pool and makes it visible to plan_find().
+ *
+ * Plans are written once and never evicted: when the pool is full, further
+ * formats are parsed on every call.  Two threads publishing the same format
+ * at once may both take an entry; only one is ever found.
+ */
+static void plan_publish(const plan_t *plan) {
+    size_t index = atomic_fetch_add_explicit(&s_n_plans, 1,
+                                             memory_order_relaxed);
+    size_t slot = plan_hash(plan->format);
+
+    if (index >= MU_LOG_FMT_PLANS) {
+        return;
+    }
+    s_plans[index] = *plan;
+    for (size_t n = 0; n < PLAN_SLOTS; n++) {
+        const plan_t *expected = NULL;
+
+        if (atomic_compare_exchange_strong_explicit(
+                &s_plan_slots[slot], &expected, &s_plans[index],
+                memory_order_release, memory_order_acquire) ||
+            expected->format == plan->format) {
+            return;
+        }
+        slot = (slot + 1) & PLAN_MASK;
+    }
+}
+
+static size_t plan_hash(const char *format) {
+    return (size_t)(((uintptr_t)format >> 2) * 2654435761u) & PLAN_MASK;
+}
+#endif
+
+#if MU_LOG_FMT_MAX_CONVS > 0
+/**
+ * @brief Renders `%{name}` through the registry.
+ *
+ * An unknown name is echoed verbatim, and still consumes its argument so the
+ * ones after it stay aligned.
+ *
+ * @param[in] spec The whole specifier, `%` through `}`.
+ * @param[in] len Its length.
+ */
+static void render_conv(out_t *out, args_t *args, const char *spec,
+                        size_t len, int width, int flags) {
+    const char *name = (const char *)memchr(spec, '{', len) + 1;
+    size_t name_len = (size_t)(spec + len - 1 - name);
+    uintptr_t value = fetch_word(args);
+
+    for (size_t i = 0; i < s_n_convs; i++) {
+        if (strncmp(s_convs[i].name, name, name_len) == 0 &&
+            s_convs[i].name[name_len] == '\0') {
+            char text[MU_LOG_FMT_CONV_MAX];
+            size_t n = s_convs[i].conv(text, sizeof(text), value);
+            emit_padded(out, text, (int)n, width, flags & ~FLAG_ZERO);
+            return;
+        }
+    }
+    emit_run(out, spec, len);
+}
+#endif
+
+static void emit(out_t *out, char ch) {
+    out->putc(ch, out->arg);
+    out->count++;
+}
+
+static void emit_string(out_t *out, const char *s) {
+    while (*s != '\0') {
+        emit(out, *s++);
+    }
+}
+
+/**
+ * @brief Emits `len` characters; copies them at once into a buffer output.
+ */
+static void emit_run(out_t *out, const char *s, size_t len) {
+    if (out->putc == buf_putc) {
+        buf_out_t *buf = (buf_out_t *)out->arg;
+        size_t room = buf->len + 1 < buf->size ? buf->size - buf->len - 1 : 0;
+        size_t n = len < room ? len : room;
+
+        // no pointer into buf once it is full (or NULL, for a length probe)
+        if (n > 0) {
+            memcpy(&buf->buf[buf->len], s, n);
+        }
+        buf->len += len;
+        out->count += (int)len;
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        emit(out, s[i]);
+    }
+}
+
+static void emit_padded(out_t *out, const char *s, int len, int width,
+                        int flags) {
+    int pad = width > len ? width - len : 0;
+
+    if (!(flags & FLAG_LEFT)) {
+        while (pad-- > 0) {
+            emit(out, ' ');
+        }
+    }
+    emit_run(out, s, (size_t)len);
+    if (flags & FLAG_LEFT) {
+        while (pad-- > 0) {
+            emit(out, ' ');
+        }
+    }
+}
+
+/**
+ * @brief Emits `prefix` ("-", "0x" or "") and `value`, padded to `width`:
+ * spaces before the prefix, or zeros after it with FLAG_ZERO.
+ */
+static void emit_unsigned(out_t *out, uintmax_t value, const char *prefix,
+                          unsigned base, bool upper, int width, int flags) {
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buf[DIGITS_MAX];
+    int len = 0;
+    int pad;
+
+    do {
+        buf[DIGITS_MAX - ++len] = digits[value % base];
+        value /= base;
+    } while (value != 0 && len < DIGITS_MAX);
+
+    pad = width - len - (int)strlen(prefix);
+    if (!(flags & (FLAG_LEFT | FLAG_ZERO))) {
+        for (; pad > 0; pad--) {
+            emit(out, ' ');
+        }
+    }
+    emit_string(out, prefix);
+    if ((flags & FLAG_ZERO) && !(flags & FLAG_LEFT)) {
+        for (; pad > 0; pad--) {
+            emit(out, '0');
+        }
+    }
+    emit_run(out, &buf[DIGITS_MAX - len], (size_t)len);
+    for (; pad > 0; pad--) {
+        emit(out, ' ');
+    }
+}
+
+static uintptr_t fetch_word(args_t *args) {
+    if (args->words == NULL) {
+        return (uintptr_t)va_arg(args->ap, void *);
+    }
+    return args->next < args->n_words ? args->words[args->next++] : 0;
+}
+
+static int fetch_int(args_t *args) {
+    if (args->words == NULL) {
+        return va_arg(args->ap, int);
+    }
+    return (int)fetch_word(args);
+}
+
+/**
+ * @brief Fetches an unsigned argument; `h` and `hh` values arrive promoted to
+ * int and are narrowed back, as printf does.
+ */
+static uintmax_t fetch_unsigned(args_t *args, int length) {
+    unsigned int value;
+
+    if (args->words != NULL) {
+        uintptr_t word = fetch_word(args);
+        if (length > LEN_INT) {
+            return (uintmax_t)word;
+        }
+        value = (unsigned int)word;
+    } else {
+        switch (length) {
+        case LEN_LONG:
+            return va_arg(args->ap, unsigned long);
+        case LEN_LLONG:
+            return va_arg(args->ap, unsigned long long);
+        case LEN_SIZE:
+            return va_arg(args->ap, size_t);
+        default:
+            value = va_arg(args->ap, unsigned int);
+            break;
+        }
+    }
+    if (length == LEN_CHAR) {
+        return (unsigned char)value;
+    }
+    return length == LEN_SHORT ? (unsigned short)value : value;
+}
+
+static intmax_t fetch_signed(args_t *args, int length) {
+    int value;
+
+    if (args->words != NULL) {
+        uintptr_t word = fetch_word(args);
+        if (length > LEN_INT) {
+            return (intmax_t)(intptr_t)word;
+        }
+        value = (int)word;
+    } else {
+        switch (length) {
+        case LEN_LONG:
+            return va_arg(args->ap, long);
+        case LEN_LLONG:
+            return va_arg(args->ap, long long);
+        case LEN_SIZE:
+            return (intmax_t)va_arg(args->ap, size_t);
+        default:
+            value = va_arg(args->ap, int);
+            break;
+        }
+    }
+    if (length == LEN_CHAR) {
+        return (signed char)value;
+    }
+    return length == LEN_SHORT ? (short)value : value;
+}
+
+/**
+ * @brief Consumes a floating-point argument, which is not rendered, so the
+ * arguments after it stay aligned.  A deferred record holds it in one word.
+ */
+static void skip_double(args_t *args, int length) {
+    if (args->words != NULL) {
+        (void)fetch_word(args);
+    } else if (length == LEN_LDOUBLE) {
+        (void)va_arg(args->ap, long double);
+    } else {
+        (void)va_arg(args->ap, double);
+    }
+}
+
+/**
+ * @brief Writes `value` in lowercase hex, at least `digits` wide.
+ */
+static size_t put_hex(char *buf, uint32_t value, int digits) {
+    int n = 1;
+
+    while (n < 8 && (value >> (4 * n)) != 0) {
+        n++;
+    }
+    if (n < digits) {
+        n = digits;
+    }
+    for (int i = 0; i < n; i++) {
+        buf[i] = "0123456789abcdef"[(value >> (4 * (n - 1 - i))) & 0xfu];
+    }
+    return (size_t)n;
+}
+
+static size_t put_decimal(char *buf, uintmax_t value) {
+    char digits[DIGITS_MAX];
+    size_t n = 0;
+    size_t len = 0;
+
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+        buf[len++] = digits[--n];
+    }
+    return len;
+}
+
+/**
+ * Copies a built-in conversion's text to the caller's buffer, truncated to
+ * `size` so that a small MU_LOG_FMT_CONV_MAX shortens output, never overruns.
+ */
+static size_t put_clipped(char *buf, size_t size, const char *text,
+                          size_t len) {
+    if (len > size) {
+        len = size;
+    }
+    memcpy(buf, text, len);
+    return len;
+}
+
+static void buf_putc(char ch, void *arg) {
+    buf_out_t *out = (buf_out_t *)arg;
+
+    if (out->len + 1 < out->size) {
+        out->buf[out->len] = ch;
+    }
+    out->len++;
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
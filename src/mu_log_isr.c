@@ -0,0 +1,295 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_isr.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include "mu_log_fmt.h"
+#include "mu_log_mem.h"
+
+#include <stddef.h>
+
+#if defined(MU_LOG_ISR_ENTER_CRITICAL) && defined(MU_LOG_ISR_EXIT_CRITICAL)
+#define MU_LOG_ISR_USE_CRITICAL 1
+#else
+#include <stdatomic.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+#if (MU_LOG_ISR_CAPACITY & (MU_LOG_ISR_CAPACITY - 1)) != 0
+#error "MU_LOG_ISR_CAPACITY must be a power of two"
+#endif
+
+#define RING_MASK (MU_LOG_ISR_CAPACITY - 1)
+
+typedef struct {
+    const char *format;
+    uintptr_t args[MU_LOG_ISR_MAX_ARGS];
+    unsigned char level;
+    unsigned char n_args;
+} record_t;
+
+#ifdef MU_LOG_ISR_USE_CRITICAL
+typedef struct {
+    record_t record;
+} slot_t;
+#else
+/**
+ * Bounded queue after D. Vyukov: `seq == pos` means the slot is free for the
+ * producer that reserves position `pos`; `seq == pos + 1` means it holds the
+ * record published at `pos`.
+ */
+typedef struct {
+    atomic_uint seq;
+    record_t record;
+} slot_t;
+#endif
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool ring_push(const record_t *record);
+static void ring_drop(void);
+static bool ring_pop(record_t *record);
+static void emit(const record_t *record);
+
+// *****************************************************************************
+// Private (static) storage
+
+static slot_t *s_ring; // from mu_log_alloc(), on first init
+static size_t s_reported_drops; // drain context only
+
+#ifdef MU_LOG_ISR_USE_CRITICAL
+static unsigned s_head;
+static unsigned s_tail;
+static volatile size_t s_dropped;
+#else
+static atomic_uint s_head;
+static unsigned s_tail; // drain context only
+static atomic_size_t s_dropped;
+#endif
+
+// *****************************************************************************
+// Public code
+
+void mu_log_isr_init(void) {
+    if (s_ring == NULL) {
+        s_ring = (slot_t *)mu_log_alloc(sizeof(slot_t) * MU_LOG_ISR_CAPACITY,
+                                        _Alignof(slot_t));
+    }
+#ifdef MU_LOG_ISR_USE_CRITICAL
+    s_head = 0;
+    s_tail = 0;
+    s_dropped = 0;
+#else
+    for (unsigned i = 0; s_ring != NULL && i < MU_LOG_ISR_CAPACITY; i++) {
+        atomic_init(&s_ring[i].seq, i);
+    }
+    atomic_init(&s_head, 0);
+    s_tail = 0;
+    atomic_init(&s_dropped, 0);
+#endif
+    s_reported_drops = 0;
+}
+
+bool mu_log_isr_post(mu_log_level_t level, const char *format, size_t n_args,
+                     uintptr_t a0, uintptr_t a1, uintptr_t a2, uintptr_t a3) {
+    record_t record;
+
+    if (!mu_log_will_log(level)) {
+        return false;
+    }
+    if (s_ring == NULL) {
+        // not initialized, or the allocator could not supply the ring
+        ring_drop();
+        return false;
+    }
+    record.format = format;
+    record.level = (unsigned char)level;
+    record.n_args = (unsigned char)n_args;
+    record.args[0] = a0;
+    record.args[1] = a1;
+    record.args[2] = a2;
+    record.args[3] = a3;
+    return ring_push(&record);
+}
+
+size_t mu_log_isr_drain(size_t max_records) {
+    size_t dropped = mu_log_isr_dropped();
+    size_t n = 0;
+    record_t record;
+
+    if (dropped != s_reported_drops) {
+        record.format = "mu_log_isr: %u records dropped";
+        record.level = MU_LOG_LEVEL_WARN;
+        record.n_args = 1;
+        record.args[0] = (uintptr_t)(dropped - s_reported_drops);
+        s_reported_drops = dropped;
+        emit(&record);
+    }
+    while ((max_records == 0 || n < max_records) && ring_pop(&record)) {
+        emit(&record);
+        n++;
+    }
+    return n;
+}
+
+size_t mu_log_isr_dropped(void) {
+#ifdef MU_LOG_ISR_USE_CRITICAL
+    return s_dropped;
+#else
+    return atomic_load_explicit(&s_dropped, memory_order_relaxed);
+#endif
+}
+
+// *****************************************************************************
+// Private (static) code
+
+#ifdef MU_LOG_ISR_USE_CRITICAL
+static bool ring_push(const record_t *record) {
+    MU_LOG_ISR_CRITICAL_STATE state;
+    bool queued = false;
+
+    MU_LOG_ISR_ENTER_CRITICAL(state);
+    if (s_head - s_tail < MU_LOG_ISR_CAPACITY) {
+        s_ring[s_head & RING_MASK].record = *record;
+        s_head++;
+        queued = true;
+    } else {
+        s_dropped++;
+    }
+    MU_LOG_ISR_EXIT_CRITICAL(state);
+    return queued;
+}
+
+static void ring_drop(void) {
+    MU_LOG_ISR_CRITICAL_STATE state;
+
+    MU_LOG_ISR_ENTER_CRITICAL(state);
+    s_dropped++;
+    MU_LOG_ISR_EXIT_CRITICAL(state);
+}
+
+static bool ring_pop(record_t *record) {
+    MU_LOG_ISR_CRITICAL_STATE state;
+    bool popped = false;
+
+    MU_LOG_ISR_ENTER_CRITICAL(state);
+    if (s_tail != s_head) {
+        *record = s_ring[s_tail & RING_MASK].record;
+        s_tail++;
+        popped = true;
+    }
+    MU_LOG_ISR_EXIT_CRITICAL(state);
+    return popped;
+}
+
+#else
+static bool ring_push(const record_t *record) {
+    unsigned pos = atomic_load_explicit(&s_head, memory_order_relaxed);
+    slot_t *slot;
+
+    for (;;) {
+        unsigned seq;
+        int diff;
+
+        slot = &s_ring[pos & RING_MASK];
+        seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        diff = (int)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&s_head, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the slot still holds an undrained record: the ring is full
+            ring_drop();
+            return false;
+        } else {
+            pos = atomic_load_explicit(&s_head, memory_order_relaxed);
+        }
+    }
+    slot->record = *record;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+static void ring_drop(void) {
+    atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+}
+
+static bool ring_pop(record_t *record) {
+    slot_t *slot;
+    unsigned seq;
+
+    if (s_ring == NULL) {
+        return false;
+    }
+    slot = &s_ring[s_tail & RING_MASK];
+    seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+    if (seq != s_tail + 1) {
+        return false; // empty, or the next producer has not published yet
+    }
+    *record = slot->record;
+    atomic_store_explicit(&slot->seq, s_tail + MU_LOG_ISR_CAPACITY,
+                          memory_order_release);
+    s_tail++;
+    return true;
+}
+#endif
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static void emit(const record_t *record) {
+    char line[MU_LOG_ISR_LINE_MAX];
+
+    mu_log_fmt_wsnprintf(line, sizeof(line), record->format, record->args,
+                         record->n_args);
+    mu_log((mu_log_level_t)record->level, "%s", line);
+}
+
+#else
+static void emit(const record_t *record) {
+    if (record->n_args != 0) {
+        char line[MU_LOG_ISR_LINE_MAX];
+        mu_log_fmt_wsnprintf(line, sizeof(line), record->format, record->args,
+                             record->n_args);
+        mu_log((mu_log_level_t)record->level, line);
+    } else {
+        mu_log((mu_log_level_t)record->level, record->format);
+    }
+}
+#endif
+
+// *****************************************************************************
+// End of file
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_mem.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void *arena_alloc_hook(void *ctx, size_t size, size_t align);
+static void arena_free_hook(void *ctx, void *ptr, size_t size);
+
+// *****************************************************************************
+// Private (static) storage
+
+static union {
+    unsigned char bytes[MU_LOG_ARENA_SIZE];
+    max_align_t align;
+} s_default_storage;
+
+static mu_log_arena_t s_default_arena = {
+    .base = s_default_storage.bytes,
+    .size = MU_LOG_ARENA_SIZE,
+};
+
+static mu_log_allocator_t s_allocator = {
+    .alloc = arena_alloc_hook,
+    .free = arena_free_hook,
+    .ctx = &s_default_arena,
+};
+
+static bool s_allocator_locked = false;
+
+// *****************************************************************************
+// Public code
+
+bool mu_log_set_allocator(const mu_log_allocator_t *allocator) {
+    if (s_allocator_locked) {
+        return false;
+    }
+    if (allocator == NULL) {
+        s_allocator = mu_log_arena_allocator(&s_default_arena);
+    } else {
+        s_allocator = *allocator;
+    }
+    return true;
+}
+
+void *mu_log_alloc(size_t size, size_t align) {
+    s_allocator_locked = true;
+    return s_allocator.alloc(s_allocator.ctx, size, align);
+}
+
+void mu_log_free(void *ptr, size_t size) {
+    if (ptr != NULL && s_allocator.free != NULL) {
+        s_allocator.free(s_allocator.ctx, ptr, size);
+    }
+}
+
+const mu_log_arena_t *mu_log_default_arena(void) {
+    return &s_default_arena;
+}
+
+void mu_log_arena_init(mu_log_arena_t *arena, void *buf, size_t size) {
+    arena->base = (unsigned char *)buf;
+    arena->size = size;
+    arena->used = 0;
+    arena->high_water = 0;
+    arena->n_allocs = 0;
+    arena->n_failed = 0;
+}
+
+mu_log_allocator_t mu_log_arena_allocator(mu_log_arena_t *arena) {
+    mu_log_allocator_t allocator = {arena_alloc_hook, arena_free_hook, arena};
+    return allocator;
+}
+
+void *mu_log_arena_alloc(mu_log_arena_t *arena, size_t size, size_t align) {
+    uintptr_t start = (uintptr_t)(arena->base + arena->used);
+    size_t pad = (size_t)(-start & (uintptr_t)(align - 1));
+
+    if (pad > arena->size - arena->used ||
+        size > arena->size - arena->used - pad) {
+        arena->n_failed++;
+        return NULL;
+    }
+    arena->used += pad + size;
+    if (arena->used > arena->high_water) {
+        arena->high_water = arena->used;
+    }
+    arena->n_allocs++;
+    return (void *)(start + pad);
+}
+
+void mu_log_arena_reset(mu_log_arena_t *arena) {
+    arena->used = 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void *arena_alloc_hook(void *ctx, size_t size, size_t align) {
+    return mu_log_arena_alloc((mu_log_arena_t *)ctx, size, align);
+}
+
+static void arena_free_hook(void *ctx, void *ptr, size_t size) {
+    mu_log_arena_t *arena = (mu_log_arena_t *)ctx;
+
+    // only the most recent block can be returned to a bump arena
+    if ((unsigned char *)ptr + size == arena->base + arena->used) {
+        arena->used -= size;
+    }
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
@@ -0,0 +1,301 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // vmsplice(), F_GETPIPE_SZ
+#endif
+
+#include "mu_log_pipe.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define HEADER_MAX 16 // "LEVEL: "; level names are short
+
+typedef struct {
+    char *data;
+    bool gifted;    // some of its pages went to the pipe
+    uint64_t mark;  // s_pages right after they did
+} buf_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static size_t splice_pages(const char *data, size_t len);
+static bool write_all(const char *data, size_t len);
+static void next_buffer(void);
+static void await_drain(void);
+static size_t header(char *out, mu_log_level_t level);
+
+// *****************************************************************************
+// Private (static) storage
+
+static int s_fd = -1;
+static bool s_zero_copy;
+static size_t s_page_size;
+static uint64_t s_pipe_slots; // pages the pipe can hold
+static buf_t s_bufs[MU_LOG_PIPE_MAX_BUFS];
+static size_t s_n_bufs;
+static size_t s_cur;
+static size_t s_used; // bytes in the current buffer
+static uint64_t s_pages; // pages gifted so far
+static mu_log_pipe_stats_t s_stats;
+
+// *****************************************************************************
+// Public code
+
+bool mu_log_pipe_init(int fd, bool zero_copy) {
+    struct stat st;
+    char *base;
+    int pipe_size = 0;
+
+    s_page_size = (size_t)sysconf(_SC_PAGESIZE);
+    if (MU_LOG_PIPE_BUF_SIZE % s_page_size != 0 || s_n_bufs != 0) {
+        return false;
+    }
+    s_zero_copy = zero_copy && fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode) &&
+                  (pipe_size = fcntl(fd, F_GETPIPE_SZ)) > 0;
+    s_pipe_slots = s_zero_copy ? (uint64_t)pipe_size / s_page_size : 0;
+    // enough buffers that, splicing whole buffers, the oldest has left the
+    // pipe by the time it comes round again
+    s_n_bufs = s_zero_copy ? (size_t)(s_pipe_slots * s_page_size /
+                                      MU_LOG_PIPE_BUF_SIZE) + 2
+                           : 1;
+    if (s_n_bufs > MU_LOG_PIPE_MAX_BUFS) {
+        s_n_bufs = MU_LOG_PIPE_MAX_BUFS;
+    }
+    base = (char *)mmap(NULL, s_n_bufs * MU_LOG_PIPE_BUF_SIZE,
+                        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1, 0);
+    if (base == MAP_FAILED) {
+        s_n_bufs = 0;
+        return false;
+    }
+    for (size_t i = 0; i < s_n_bufs; i++) {
+        s_bufs[i].data = base + i * MU_LOG_PIPE_BUF_SIZE;
+        s_bufs[i].gifted = false;
+    }
+    s_fd = fd;
+    s_cur = 0;
+    s_used = 0;
+    s_pages = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+    return true;
+}
+
+void mu_log_pipe_close(void) {
+    if (s_n_bufs == 0) {
+        return;
+    }
+    mu_log_pipe_flush();
+    // pages still in the pipe stay referenced by it, not by the mapping
+    munmap(s_bufs[0].data, s_n_bufs * MU_LOG_PIPE_BUF_SIZE);
+    s_n_bufs = 0;
+    s_fd = -1;
+}
+
+void mu_log_pipe_writer(mu_log_level_t level, const char *data, size_t len,
+                        void *arg) {
+    char prefix[HEADER_MAX];
+    size_t n_prefix;
+    size_t need;
+    char *out;
+
+    (void)arg;
+    if (s_n_bufs == 0) {
+        return;
+    }
+    n_prefix = header(prefix, level);
+    need = n_prefix + len + 1;
+    if (s_used + need > MU_LOG_PIPE_BUF_SIZE) {
+        mu_log_pipe_flush();
+    }
+    if (need > MU_LOG_PIPE_BUF_SIZE) {
+        // longer than a buffer: straight out, after what was buffered
+        if (write_all(prefix, n_prefix) && write_all(data, len)) {
+            write_all("\n", 1);
+        }
+        return;
+    }
+    out = s_bufs[s_cur].data + s_used;
+    memcpy(out, prefix, n_prefix);
+    memcpy(out + n_prefix, data, len);
+    out[n_prefix + len] = '\n';
+    s_used += need;
+}
+
+bool mu_log_pipe_flush(void) {
+    buf_t *buf;
+    size_t gifted = 0;
+    bool ok = true;
+
+    if (s_n_bufs == 0 || s_used == 0) {
+        return true;
+    }
+    buf = &s_bufs[s_cur];
+    if (s_zero_copy && s_used >= s_page_size) {
+        gifted = splice_pages(buf->data, s_used & ~(s_page_size - 1));
+        if (gifted != 0) {
+            buf->gifted = true;
+            buf->mark = s_pages;
+        } else if (errno != EAGAIN) {
+            s_zero_copy = false; // refused: copy from now on
+        }
+    }
+    if (s_used > gifted) {
+        ok = write_all(buf->data + gifted, s_used - gifted);
+    }
+    s_used = 0;
+    if (buf->gifted) {
+        next_buffer();
+    }
+    return ok;
+}
+
+void mu_log_pipe_stats(mu_log_pipe_stats_t *stats) {
+    *stats = s_stats;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Gifts pages to the pipe.
+ *
+ * @return Bytes gifted; fewer than `len` if vmsplice() failed.
+ */
+static size_t splice_pages(const char *data, size_t len) {
+    struct iovec iov = {(void *)data, len};
+
+    while (iov.iov_len > 0) {
+        ssize_t n = vmsplice(s_fd, &iov, 1, SPLICE_F_GIFT);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        // a transfer ending mid-page still takes that page's slot
+        s_pages += ((size_t)n + s_page_size - 1) / s_page_size;
+        s_stats.spliced += (uint64_t)n;
+        iov.iov_base = (char *)iov.iov_base + n;
+        iov.iov_len -= (size_t)n;
+    }
+    return len - iov.iov_len;
+}
+
+static bool write_all(const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(s_fd, data, len);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        s_stats.written += (uint64_t)n;
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Moves to the next buffer, making sure the pipe no longer holds its
+ * pages.
+ */
+static void next_buffer(void) {
+    buf_t *buf;
+
+    s_cur = (s_cur + 1) % s_n_bufs;
+    buf = &s_bufs[s_cur];
+    if (buf->gifted && s_pages - buf->mark < s_pipe_slots) {
+        // may still be in the pipe: swap in fresh pages instead of waiting
+        if (mmap(buf->data, MU_LOG_PIPE_BUF_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1,
+                 0) != MAP_FAILED) {
+            s_stats.remaps++;
+        } else {
+            // this buffer's old pages may be gone as well: copy from now
+            // on, into the next buffer once the pipe lets go of it
+            s_zero_copy = false;
+            await_drain();
+            s_cur = (s_cur + 1) % s_n_bufs;
+            buf = &s_bufs[s_cur];
+        }
+    }
+    buf->gifted = false;
+}
+
+/**
+ * @brief Waits until the reader has taken everything queued in the pipe, and
+ * with it every page gifted so far.
+ */
+static void await_drain(void) {
+    struct timespec pause = {0, 1000000};
+    int queued;
+
+    while (ioctl(s_fd, FIONREAD, &queued) == 0 && queued > 0) {
+        nanosleep(&pause, NULL);
+    }
+}
+
+/**
+ * @brief Writes the `LEVEL: ` prefix, as `mu_log_buf_stdout_writer` does.
+ */
+static size_t header(char *out, mu_log_level_t level) {
+    const char *name = mu_log_level_name(level);
+    size_t len = strlen(name);
+    size_t pad = 0;
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+    pad = len < 5 ? 5 - len : 0; // "%5s: "
+    memset(out, ' ', pad);
+#endif
+    memcpy(out + pad, name, len);
+    memcpy(out + pad + len, ": ", 2);
+    return pad + len + 2;
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
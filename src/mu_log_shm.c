@@ -0,0 +1,269 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_shm.h"
+
+#if defined(MU_LOG_SHM) && (defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED)) // whole file
+
+#ifdef MU_LOG_ROUTES
+#include "mu_log_cfg.h"
+#endif
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SITE_OFF (MU_LOG_LEVEL_FATAL + 1) // a threshold nothing reaches
+
+_Static_assert(sizeof(mu_log_shm_page_t) == MU_LOG_SHM_PAGE_SIZE,
+               "the control page must be exactly one page");
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static int list_module(const char *name);
+static int list_site(mu_log_site_t *site, int module);
+static void lock_tables(void);
+static void unlock_tables(void);
+static void page_name(char *name, size_t size, int pid);
+
+// *****************************************************************************
+// Private (static) storage
+
+// Aligned so that mu_log_shm_init() can map shared memory over exactly it
+_Alignas(MU_LOG_SHM_PAGE_SIZE) mu_log_shm_page_t mu_log_shm_page = {
+    .magic = MU_LOG_SHM_MAGIC,
+    .version = MU_LOG_SHM_VERSION,
+    .threshold = MU_LOG_DEFAULT_LEVEL,
+};
+
+// *****************************************************************************
+// Public code
+
+bool mu_log_shm_init(void) {
+    char name[32];
+    void *page;
+    int fd;
+
+    mu_log_shm_page.pid = (int32_t)getpid();
+    page_name(name, sizeof(name), mu_log_shm_page.pid);
+    fd = shm_open(name, O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    // seed the shared object with the page, then map it in place of the page
+    if (pwrite(fd, &mu_log_shm_page, sizeof(mu_log_shm_page), 0) !=
+        (ssize_t)sizeof(mu_log_shm_page)) {
+        close(fd);
+        shm_unlink(name);
+        return false;
+    }
+    page = mmap(&mu_log_shm_page, sizeof(mu_log_shm_page),
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    close(fd);
+    if (page == MAP_FAILED) {
+        shm_unlink(name);
+        return false;
+    }
+    return true;
+}
+
+void mu_log_shm_close(void) {
+    char name[32];
+
+    page_name(name, sizeof(name), mu_log_shm_page.pid);
+    shm_unlink(name);
+}
+
+mu_log_shm_page_t *mu_log_shm_attach(int pid) {
+    mu_log_shm_page_t *page;
+    char name[32];
+    int fd;
+
+    page_name(name, sizeof(name), pid);
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+    page = (mu_log_shm_page_t *)mmap(NULL, sizeof(*page),
+                                     PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (page == MAP_FAILED) {
+        return NULL;
+    }
+    if (page->magic != MU_LOG_SHM_MAGIC || page->version != MU_LOG_SHM_VERSION) {
+        munmap(page, sizeof(*page));
+        return NULL;
+    }
+    return page;
+}
+
+void mu_log_shm_detach(mu_log_shm_page_t *page) {
+    munmap(page, sizeof(*page));
+}
+
+void mu_log_shm_set_module(mu_log_shm_page_t *page, int module,
+                           int threshold) {
+    page->modules[module].threshold = threshold;
+    __atomic_fetch_add(&page->generation, 1, __ATOMIC_RELEASE);
+}
+
+void mu_log_shm_set_site(mu_log_shm_page_t *page, int site, bool enabled) {
+    page->sites[site].enabled = enabled ? 1 : 0;
+    __atomic_fetch_add(&page->generation, 1, __ATOMIC_RELEASE);
+}
+
+void mu_log_site_resolve(mu_log_site_t *site) {
+    unsigned generation = MU_LOG_LOAD_ACQUIRE(&mu_log_shm_page.generation);
+    mu_log_level_t threshold = MU_LOG_LEVEL_TRACE;
+    int module = -1;
+    int index;
+
+    if (site->module != NULL) {
+        int32_t override = MU_LOG_SHM_NO_OVERRIDE;
+
+        module = list_module(site->module->name);
+        if (module >= 0) {
+            override = mu_log_shm_page.modules[module].threshold;
+        }
+#ifdef MU_LOG_MODULES
+        if (override == MU_LOG_SHM_NO_OVERRIDE) {
+            mu_log_module_resolve(site->module);
+            override = (int32_t)site->module->threshold;
+        }
+#endif
+        if (override != MU_LOG_SHM_NO_OVERRIDE) {
+            threshold = (mu_log_level_t)override;
+        }
+    }
+    index = list_site(site, module);
+    if (index < MU_LOG_SHM_MAX_SITES &&
+        !mu_log_shm_page.sites[index].enabled) {
+        threshold = (mu_log_level_t)SITE_OFF;
+    }
+    MU_LOG_STORE_RELAXED(&site->threshold, threshold);
+#ifdef MU_LOG_ROUTES
+    mu_log_cfg_route_site(site, threshold);
+#endif
+    // publish after the threshold and routes; a stale generation only causes
+    // another refresh
+    MU_LOG_STORE_RELEASE(&site->generation, generation);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Finds or adds a module entry; -1 if the table is full.
+ */
+static int list_module(const char *name) {
+    int index = -1;
+    uint32_t n;
+
+    lock_tables();
+    n = mu_log_shm_page.n_modules;
+    for (uint32_t i = 0; i < n; i++) {
+        if (strncmp(mu_log_shm_page.modules[i].name, name,
+                    MU_LOG_SHM_NAME_MAX - 1) == 0) {
+            index = (int)i;
+            break;
+        }
+    }
+    if (index < 0 && n < MU_LOG_SHM_MAX_MODULES) {
+        mu_log_shm_module_t *entry = &mu_log_shm_page.modules[n];
+        snprintf(entry->name, sizeof(entry->name), "%s", name);
+        entry->threshold = MU_LOG_SHM_NO_OVERRIDE;
+        atomic_thread_fence(memory_order_release);
+        mu_log_shm_page.n_modules = n + 1;
+        index = (int)n;
+    }
+    unlock_tables();
+    return index;
+}
+
+/**
+ * @brief Adds a site entry the first time the site is seen, and returns it;
+ * MU_LOG_SHM_MAX_SITES (always enabled, not listed) if the table is full.
+ *
+ * The check and the append share the lock, so two threads reaching a new
+ * site together list it once.
+ */
+static int list_site(mu_log_site_t *site, int module) {
+    const char *base = strrchr(site->file, '/');
+    uint32_t n;
+    int index;
+
+    lock_tables();
+    if (site->index >= 0) {
+        index = site->index;
+        unlock_tables();
+        return index;
+    }
+    n = mu_log_shm_page.n_sites;
+    if (n < MU_LOG_SHM_MAX_SITES) {
+        mu_log_shm_site_t *entry = &mu_log_shm_page.sites[n];
+        snprintf(entry->file, sizeof(entry->file), "%s",
+                 base != NULL ? base + 1 : site->file);
+        entry->line = site->line;
+        entry->module = module;
+        entry->enabled = 1;
+        atomic_thread_fence(memory_order_release);
+        mu_log_shm_page.n_sites = n + 1;
+    }
+    site->index = (int)n;
+    unlock_tables();
+    return (int)n;
+}
+
+/**
+ * @brief Takes the page's own lock, which every process mapping the page
+ * shares (a lock-free atomic in shared memory works across processes).
+ */
+static void lock_tables(void) {
+    while (__atomic_exchange_n(&mu_log_shm_page.tables_lock, 1,
+                               __ATOMIC_ACQUIRE) != 0) {
+    }
+}
+
+static void unlock_tables(void) {
+    __atomic_store_n(&mu_log_shm_page.tables_lock, 0, __ATOMIC_RELEASE);
+}
+
+static void page_name(char *name, size_t size, int pid) {
+    snprintf(name, size, MU_LOG_SHM_NAME_FORMAT, pid);
+}
+
+// *****************************************************************************
+// End of file
+
+#endif
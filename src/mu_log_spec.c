@@ -0,0 +1,358 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_spec.h"
+
+#if defined(MU_LOG_ENABLE) || defined(MU_LOG_ENABLE_FORMATTED) // whole file
+
+#include <ctype.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MU_LOG_SPEC_POSIX 1
+#include <signal.h>
+#include <time.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool parse_rule(const char *rule, size_t len, mu_log_config_t *config,
+                       uint64_t now);
+static bool parse_level(const char *text, size_t len, mu_log_level_t *level);
+static bool reload(void);
+static bool expire(void);
+static bool read_file(const char *path, char *spec, size_t size);
+#ifdef MU_LOG_SPEC_POSIX
+static uint64_t monotonic_ms(void);
+static void sighup_handler(int sig);
+#endif
+#ifdef __linux__
+static bool file_changed(void);
+#endif
+
+// *****************************************************************************
+// Private (static) storage
+
+#ifdef MU_LOG_SPEC_POSIX
+static mu_log_spec_clock_fn s_clock = monotonic_ms;
+#else
+static mu_log_spec_clock_fn s_clock;
+#endif
+static atomic_bool s_reload_requested;
+static const char *s_path; // reload source; NULL: the environment
+#ifdef __linux__
+static int s_inotify_fd = -1;
+#endif
+
+// *****************************************************************************
+// Public code
+
+bool mu_log_spec_parse(const char *spec, mu_log_config_t *config) {
+    mu_log_config_t parsed = *config;
+    uint64_t now = s_clock != NULL ? s_clock() : 0;
+
+    parsed.module_default = MU_LOG_DEFAULT_LEVEL;
+    parsed.n_modules = 0;
+    while (*spec != '\0') {
+        size_t len = strcspn(spec, ",");
+        if (!parse_rule(spec, len, &parsed, now)) {
+            return false;
+        }
+        spec += spec[len] == ',' ? len + 1 : len;
+    }
+    *config = parsed;
+    return true;
+}
+
+bool mu_log_spec_apply(const char *spec) {
+    const mu_log_config_t *current = mu_log_cfg_current();
+    mu_log_config_t config;
+
+    if (current == NULL) {
+        return false;
+    }
+    config = *current;
+    return mu_log_spec_parse(spec, &config) && mu_log_cfg_publish(&config);
+}
+
+bool mu_log_spec_init(void) {
+    const char *spec = getenv(MU_LOG_SPEC_ENV);
+    return spec == NULL || mu_log_spec_apply(spec);
+}
+
+void mu_log_spec_set_clock(mu_log_spec_clock_fn clock) {
+    s_clock = clock;
+}
+
+void mu_log_spec_request_reload(void) {
+    atomic_store(&s_reload_requested, true);
+}
+
+bool mu_log_spec_watch_sighup(void) {
+#ifdef MU_LOG_SPEC_POSIX
+    struct sigaction sa;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sighup_handler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    return sigaction(SIGHUP, &sa, NULL) == 0;
+#else
+    return false;
+#endif
+}
+
+bool mu_log_spec_watch_file(const char *path) {
+#ifdef __linux__
+    // watch the directory: editors replace files rather than rewrite them
+    char dir[256] = ".";
+    const char *slash = strrchr(path, '/');
+    bool watchable = true;
+
+    if (slash == path) {
+        strcpy(dir, "/");
+    } else if (slash != NULL) {
+        size_t len = (size_t)(slash - path);
+        watchable = len < sizeof(dir);
+        if (watchable) {
+            memcpy(dir, path, len);
+            dir[len] = '\0';
+        }
+    }
+    if (s_inotify_fd < 0) {
+        s_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    }
+    if (s_inotify_fd >= 0 && watchable) {
+        inotify_add_watch(s_inotify_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+    }
+#endif
+    s_path = path;
+    return reload();
+}
+
+bool mu_log_spec_poll(void) {
+    bool published = false;
+    bool requested = atomic_exchange(&s_reload_requested, false);
+
+#ifdef __linux__
+    requested = file_changed() || requested;
+#endif
+    if (requested) {
+        published = reload();
+    }
+    return expire() || published;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool parse_rule(const char *rule, size_t len, mu_log_config_t *config,
+                       uint64_t now) {
+    const char *eq = memchr(rule, '=', len);
+    const char *name = rule;
+    const char *level_text = eq != NULL ? eq + 1 : rule;
+    size_t name_len = eq != NULL ? (size_t)(eq - rule) : 0;
+    size_t level_len = len - (size_t)(level_text - rule);
+    const char *colon = memchr(level_text, ':', level_len);
+    mu_log_cfg_module_t *module;
+    mu_log_level_t level;
+    uint64_t expires = 0;
+
+    // trim the name
+    while (name_len > 0 && isspace((unsigned char)*name)) {
+        name++;
+        name_len--;
+    }
+    while (name_len > 0 && isspace((unsigned char)name[name_len - 1])) {
+        name_len--;
+    }
+    if (colon != NULL) {
+        char *end;
+        unsigned long seconds = strtoul(colon + 1, &end, 10);
+
+        while (end < level_text + level_len && isspace((unsigned char)*end)) {
+            end++;
+        }
+        if (s_clock == NULL || end == colon + 1 ||
+            end != level_text + level_len) {
+            return false;
+        }
+        expires = now + (uint64_t)seconds * 1000;
+        level_len = (size_t)(colon - level_text);
+    }
+    if (!parse_level(level_text, level_len, &level)) {
+        // an empty rule (e.g. a trailing comma) is allowed
+        return eq == NULL && colon == NULL &&
+               strspn(rule, " \t\r\n") >= len;
+    }
+    if (name_len == 0 && eq != NULL) {
+        return false; // "=debug"
+    }
+    if (name_len == 0 || (name_len == 1 && *name == '*')) {
+        if (expires != 0) {
+            return false; // the default cannot expire
+        }
+        config->module_default = level;
+        return true;
+    }
+    if (config->n_modules == MU_LOG_CFG_MAX_MODULES ||
+        name_len >= MU_LOG_CFG_MODULE_NAME_MAX) {
+        return false;
+    }
+    module = &config->modules[config->n_modules++];
+    memcpy(module->name, name, name_len);
+    module->name[name_len] = '\0';
+    module->threshold = level;
+    module->expires = expires;
+    return true;
+}
+
+static bool parse_level(const char *text, size_t len, mu_log_level_t *level) {
+    while (len > 0 && isspace((unsigned char)*text)) {
+        text++;
+        len--;
+    }
+    while (len > 0 && isspace((unsigned char)text[len - 1])) {
+        len--;
+    }
+    for (int i = MU_LOG_LEVEL_TRACE; i <= MU_LOG_LEVEL_FATAL; i++) {
+        const char *name = mu_log_level_name((mu_log_level_t)i);
+        size_t n = 0;
+
+        while (n < len && name[n] != '\0' &&
+               toupper((unsigned char)text[n]) == name[n]) {
+            n++;
+        }
+        if (n == len && name[n] == '\0') {
+            *level = (mu_log_level_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool reload(void) {
+    char spec[MU_LOG_SPEC_MAX];
+
+    if (s_path == NULL) {
+        return mu_log_spec_init() && getenv(MU_LOG_SPEC_ENV) != NULL;
+    }
+    return read_file(s_path, spec, sizeof(spec)) && mu_log_spec_apply(spec);
+}
+
+static bool expire(void) {
+    const mu_log_config_t *current = mu_log_cfg_current();
+    mu_log_config_t config;
+    uint64_t now;
+    size_t kept = 0;
+
+    if (current == NULL || s_clock == NULL) {
+        return false;
+    }
+    now = s_clock();
+    config = *current;
+    for (size_t i = 0; i < config.n_modules; i++) {
+        if (config.modules[i].expires == 0 || config.modules[i].expires > now) {
+            config.modules[kept++] = config.modules[i];
+        }
+    }
+    if (kept == config.n_modules) {
+        return false;
+    }
+    config.n_modules = kept;
+    return mu_log_cfg_publish(&config);
+}
+
+static bool read_file(const char *path, char *spec, size_t size) {
+    FILE *file = fopen(path, "r");
+    size_t n;
+
+    if (file == NULL) {
+        return false;
+    }
+    n = fread(spec, 1, size - 1, file);
+    fclose(file);
+    spec[n] = '\0';
+    while (n > 0 && isspace((unsigned char)spec[n - 1])) {
+        spec[--n] = '\0';
+    }
+    return true;
+}
+
+#ifdef MU_LOG_SPEC_POSIX
+static uint64_t monotonic_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+static void sighup_handler(int sig) {
+    (void)sig;
+    mu_log_spec_request_reload();
+}
+#endif
+
+#ifdef __linux__
+static bool file_changed(void) {
+    _Alignas(struct inotify_event) char events[1024];
+    const char *base;
+    bool changed = false;
+    ssize_t n;
+
+    if (s_inotify_fd < 0 || s_path == NULL) {
+        return false;
+    }
+    base = strrchr(s_path, '/') != NULL ? strrchr(s_path, '/') + 1 : s_path;
+    while ((n = read(s_inotify_fd, events, sizeof(events))) > 0) {
+        for (char *p = events; p < events + n;) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            if (ev->len > 0 && strcmp(ev->name, base) == 0) {
+                changed = true;
+            }
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+    return changed;
+}
+#endif
+
+// *****************************************************************************
+// End of file
+
+#endif
@@ -169,6 +169,19 @@ void test_mu_log_executes_logging(void) {
     TEST_ASSERT_EQUAL(1, mock_print_fn_fake.call_count);
 }
 
+/**
+ * @brief Test that the default compile-time floor keeps every level macro.
+ */
+void test_mu_log_compile_threshold_default(void) {
+    TEST_ASSERT_EQUAL(MU_LOG_LEVEL_TRACE, MU_LOG_COMPILE_THRESHOLD);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_TRACE);
+
+    MU_LOG_TRACE("trace");
+    MU_LOG_FATAL("fatal");
+
+    TEST_ASSERT_EQUAL(2, mock_print_fn_fake.call_count);
+}
+
 void test_mu_log_level_name(void) {
     TEST_ASSERT_EQUAL_STRING("TRACE", mu_log_level_name(MU_LOG_LEVEL_TRACE));
     TEST_ASSERT_EQUAL_STRING("DEBUG", mu_log_level_name(MU_LOG_LEVEL_DEBUG));
@@ -237,6 +250,7 @@ int main(void) {
     RUN_TEST(test_mu_log_will_log);
     RUN_TEST(test_mu_log_set_threshold);
     RUN_TEST(test_mu_log_executes_logging);
+    RUN_TEST(test_mu_log_compile_threshold_default);
     RUN_TEST(test_mu_log_level_name);
     RUN_TEST(test_mu_log_stdout_fn_calls_stdout_fns_correctly);
     RUN_TEST(test_mu_log_stdout_fn_below_threshold);
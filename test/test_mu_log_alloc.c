@@ -0,0 +1,299 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_alloc.c
+ * @brief Asserts that steady-state logging never touches the heap.
+ *
+ * The test interposes `malloc()` and friends (forwarding to glibc's
+ * `__libc_*` entry points) so that allocations made anywhere in the process,
+ * including inside stdio, are counted.  Each sink gets a warm-up call first so
+ * one-time setup such as stdio buffer allocation is excluded.  Every sink in
+ * the library is covered; the ring-backed ones are drained as they go.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+#include "mu_log_brk.h"
+#include "mu_log_buf.h"
+#include "mu_log_evt.h"
+#include "mu_log_fc.h"
+#include "mu_log_fmt.h"
+#include "mu_log_mem.h"
+#include "mu_log_pipe.h"
+#include "unity.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_LOG_CALLS 1000
+#define ARENA_SIZE 8192      // the ring and the fc slots
+#define RING_SIZE 2048
+#define PIPE_FLUSH_EVERY 200 // enough for whole pages to be gifted
+
+// *****************************************************************************
+// Heap interposition
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *ptr);
+
+static volatile size_t s_allocs;
+static volatile size_t s_frees;
+
+static int s_stdout_fd = -1;
+static int s_null_fd = -1;
+static int s_pipe[2] = {-1, -1};
+static _Alignas(64) unsigned char s_arena_buf[ARENA_SIZE];
+static mu_log_arena_t s_arena;
+
+void *malloc(size_t size) {
+    s_allocs++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    s_allocs++;
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    s_allocs++;
+    return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    s_allocs++;
+    return __libc_memalign(alignment, size);
+}
+
+void free(void *ptr) {
+    if (ptr != NULL) {
+        s_frees++;
+    }
+    __libc_free(ptr);
+}
+
+// *****************************************************************************
+// Sinks and helpers
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int null_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)format;
+    (void)ap;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#else
+static int null_sink(mu_log_level_t level, const char *message) {
+    (void)message;
+    return MU_LOG_WILL_LOG(level) ? 1 : 0;
+}
+#endif
+
+static void null_putc(char ch, void *arg) {
+    (void)ch;
+    (void)arg;
+}
+
+static void drain_buf(void) {
+    mu_log_buf_drain(mu_log_buf_stdout_writer, NULL, 0);
+}
+
+static void drain_evt(void) {
+    mu_log_evt_drain(0);
+}
+
+/**
+ * @brief Moves the ring into the pipe sink, flushing (and so gifting pages)
+ * now and then, and empties the pipe as its reader would.
+ */
+static void drain_pipe(void) {
+    static int calls;
+    char buf[4096];
+
+    mu_log_buf_drain(mu_log_pipe_writer, NULL, 0);
+    if (++calls % PIPE_FLUSH_EVERY == 0) {
+        mu_log_pipe_flush();
+    }
+    while (read(s_pipe[0], buf, sizeof(buf)) > 0) {
+    }
+}
+
+/**
+ * @brief Logs at every level; the threshold suppresses some of them.
+ */
+static void log_all_levels(int i) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_TRACE("trace %d", i);
+    MU_LOG_DEBUG("debug %d %s", i, "str");
+    MU_LOG_INFO("info %d %x %s", i, i, "str");
+    MU_LOG_WARN("warn %5.2f", (double)i);
+    MU_LOG_ERROR("error %p", (void *)&i);
+    MU_LOG_FATAL("fatal %ld", (long)i);
+#else
+    (void)i;
+    MU_LOG_TRACE("trace");
+    MU_LOG_DEBUG("debug");
+    MU_LOG_INFO("info");
+    MU_LOG_WARN("warn");
+    MU_LOG_ERROR("error");
+    MU_LOG_FATAL("fatal");
+#endif
+}
+
+/**
+ * @brief Warms up the current sink, then counts heap calls over N log calls,
+ * calling `drain` (if not NULL) after each round.
+ */
+static void assert_no_allocations(void (*drain)(void)) {
+    // Unity reports through stdout, so only the log output goes to /dev/null.
+    fflush(stdout);
+    dup2(s_null_fd, STDOUT_FILENO);
+
+    log_all_levels(0);
+    if (drain != NULL) {
+        drain();
+    }
+    s_allocs = 0;
+    s_frees = 0;
+    for (int i = 0; i < N_LOG_CALLS; i++) {
+        log_all_levels(i);
+        if (drain != NULL) {
+            drain();
+        }
+    }
+
+    fflush(stdout);
+    dup2(s_stdout_fd, STDOUT_FILENO);
+    TEST_ASSERT_EQUAL_size_t(0, s_allocs);
+    TEST_ASSERT_EQUAL_size_t(0, s_frees);
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_null_sink_does_not_allocate(void) {
+    MU_LOG_SET_FN(null_sink);
+    assert_no_allocations(NULL);
+}
+
+void test_stdout_sink_does_not_allocate(void) {
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+    assert_no_allocations(NULL);
+}
+
+void test_suppressed_path_does_not_allocate(void) {
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_FATAL + 1);
+    assert_no_allocations(NULL);
+}
+
+void test_putc_sink_does_not_allocate(void) {
+    mu_log_set_putc(null_putc, NULL);
+    MU_LOG_SET_FN(mu_log_putc_fn);
+    assert_no_allocations(NULL);
+}
+
+void test_buf_sink_does_not_allocate(void) {
+    MU_LOG_SET_FN(mu_log_buf_fn);
+    assert_no_allocations(drain_buf);
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_buf_dropped());
+}
+
+void test_fc_sink_does_not_allocate(void) {
+    MU_LOG_SET_FN(mu_log_fc_fn);
+    assert_no_allocations(NULL);
+}
+
+void test_evt_sink_does_not_allocate(void) {
+    MU_LOG_SET_FN(mu_log_evt_fn);
+    assert_no_allocations(drain_evt);
+}
+
+void test_brk_sink_does_not_allocate(void) {
+    mu_log_brk_init(mu_log_stdout_fn, 1000000000, 1000000000);
+    MU_LOG_SET_FN(mu_log_brk_fn);
+    assert_no_allocations(NULL);
+}
+
+void test_pipe_sink_does_not_allocate(void) {
+    mu_log_pipe_stats_t stats;
+
+    MU_LOG_SET_FN(mu_log_buf_fn);
+    assert_no_allocations(drain_pipe);
+    TEST_ASSERT_TRUE(mu_log_pipe_flush());
+    mu_log_pipe_stats(&stats);
+    TEST_ASSERT_TRUE(stats.spliced > 0); // the zero-copy path ran too
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    mu_log_allocator_t allocator;
+
+    s_stdout_fd = dup(STDOUT_FILENO);
+    s_null_fd = open("/dev/null", O_WRONLY);
+    if (pipe(s_pipe) != 0) {
+        return 1;
+    }
+    fcntl(s_pipe[0], F_SETFL, O_NONBLOCK);
+    // one-time setup, from an arena and mmap(), before anything is counted
+    mu_log_arena_init(&s_arena, s_arena_buf, sizeof(s_arena_buf));
+    allocator = mu_log_arena_allocator(&s_arena);
+    if (!mu_log_set_allocator(&allocator) || !mu_log_buf_init(RING_SIZE) ||
+        !mu_log_fc_init(s_null_fd) ||
+        mu_log_evt_init(mu_log_buf_stdout_writer, NULL) < 0 ||
+        !mu_log_pipe_init(s_pipe[1], true)) {
+        return 1;
+    }
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_null_sink_does_not_allocate);
+    RUN_TEST(test_stdout_sink_does_not_allocate);
+    RUN_TEST(test_suppressed_path_does_not_allocate);
+    RUN_TEST(test_putc_sink_does_not_allocate);
+    RUN_TEST(test_buf_sink_does_not_allocate);
+    RUN_TEST(test_fc_sink_does_not_allocate);
+    RUN_TEST(test_evt_sink_does_not_allocate);
+    RUN_TEST(test_brk_sink_does_not_allocate);
+    RUN_TEST(test_pipe_sink_does_not_allocate);
+
+    return UNITY_END();
+}
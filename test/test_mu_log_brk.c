@@ -0,0 +1,176 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_brk.c
+ * @brief Unit tests for the sink circuit breaker.
+ *
+ * A fake clock stands in for time: the test sink advances it by the delay
+ * the test gives it, or fails outright.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_brk.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_SIZE 4096
+#define SLOW_NS 1000
+#define PROBE_NS 1000000
+#define N_LINES 16
+#define LINE_MAX_LEN 64
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static uint64_t s_now;
+static uint64_t s_delay; // how long each sink call takes
+static bool s_failing;
+static char s_lines[N_LINES][LINE_MAX_LEN];
+static size_t s_n_lines;
+
+static uint64_t fake_clock(void) {
+    return s_now;
+}
+
+static int record_line(const char *line) {
+    s_now += s_delay;
+    if (s_failing) {
+        return -1;
+    }
+    if (s_n_lines < N_LINES) {
+        snprintf(s_lines[s_n_lines++], LINE_MAX_LEN, "%s", line);
+    }
+    return (int)strlen(line);
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int test_sink(mu_log_level_t level, const char *format, va_list ap) {
+    char line[LINE_MAX_LEN];
+    (void)level;
+    vsnprintf(line, sizeof(line), format, ap);
+    return record_line(line);
+}
+#else
+static int test_sink(mu_log_level_t level, const char *message) {
+    (void)level;
+    return record_line(message);
+}
+#endif
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    s_now = 0;
+    s_delay = 0;
+    s_failing = false;
+    s_n_lines = 0;
+    memset(s_lines, 0, sizeof(s_lines));
+    TEST_ASSERT_TRUE(mu_log_buf_init(RING_SIZE));
+    mu_log_brk_set_clock(fake_clock);
+    mu_log_brk_init(test_sink, SLOW_NS, PROBE_NS);
+    MU_LOG_SET_FN(mu_log_brk_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_DEBUG);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_brk_closed_passes_through(void) {
+    MU_LOG_INFO("one");
+    TEST_ASSERT_EQUAL_INT(MU_LOG_BRK_CLOSED, mu_log_brk_state());
+    TEST_ASSERT_EQUAL_size_t(1, s_n_lines);
+    TEST_ASSERT_EQUAL_STRING("one", s_lines[0]);
+}
+
+void test_brk_slow_call_trips(void) {
+    s_delay = 2 * SLOW_NS;
+    MU_LOG_INFO("slow");
+    TEST_ASSERT_EQUAL_INT(MU_LOG_BRK_OPEN, mu_log_brk_state());
+    TEST_ASSERT_EQUAL_size_t(1, mu_log_brk_trips());
+
+    MU_LOG_INFO("held");
+    TEST_ASSERT_EQUAL_size_t(1, s_n_lines); // only the slow call got through
+}
+
+void test_brk_failed_record_is_kept(void) {
+    s_failing = true;
+    MU_LOG_INFO("lost?");
+    TEST_ASSERT_EQUAL_INT(MU_LOG_BRK_OPEN, mu_log_brk_state());
+
+    // recover: the next record after the probe interval replays the backlog
+    s_failing = false;
+    s_now += PROBE_NS;
+    MU_LOG_INFO("after");
+    TEST_ASSERT_EQUAL_INT(MU_LOG_BRK_CLOSED, mu_log_brk_state());
+    TEST_ASSERT_EQUAL_size_t(4, s_n_lines);
+    TEST_ASSERT_EQUAL_STRING("mu_log_brk: sink failed (0 us), buffering",
+                             s_lines[0]);
+    TEST_ASSERT_EQUAL_STRING("lost?", s_lines[1]);
+    TEST_ASSERT_EQUAL_STRING("after", s_lines[2]);
+    TEST_ASSERT_EQUAL_STRING("mu_log_brk: sink recovered, 0 records dropped",
+                             s_lines[3]);
+}
+
+void test_brk_probe_waits_and_retries(void) {
+    s_delay = 2 * SLOW_NS;
+    MU_LOG_INFO("slow");
+    s_n_lines = 0;
+
+    MU_LOG_INFO("early"); // before the probe interval: no sink call
+    TEST_ASSERT_EQUAL_size_t(0, s_n_lines);
+
+    s_now += PROBE_NS;
+    MU_LOG_INFO("still slow"); // probe: one slow replay, stays open
+    TEST_ASSERT_EQUAL_INT(MU_LOG_BRK_OPEN, mu_log_brk_state());
+    TEST_ASSERT_EQUAL_size_t(1, s_n_lines);
+
+    s_delay = 0;
+    s_now += PROBE_NS;
+    MU_LOG_INFO("fast");
+    TEST_ASSERT_EQUAL_INT(MU_LOG_BRK_CLOSED, mu_log_brk_state());
+    TEST_ASSERT_EQUAL_STRING("early", s_lines[1]);
+    TEST_ASSERT_EQUAL_STRING("still slow", s_lines[2]);
+    TEST_ASSERT_EQUAL_STRING("fast", s_lines[3]);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_brk_closed_passes_through);
+    RUN_TEST(test_brk_slow_call_trips);
+    RUN_TEST(test_brk_failed_record_is_kept);
+    RUN_TEST(test_brk_probe_waits_and_retries);
+
+    return UNITY_END();
+}
@@ -0,0 +1,297 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_buf.c
+ * @brief Unit tests for the buffered reserve/commit ring.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_buf.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_SIZE 1024
+#define N_THREADS 4
+#define N_PER_THREAD 5000
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static char s_text[8][64];
+static mu_log_level_t s_levels[8];
+static size_t s_n_records;
+
+// Threaded test bookkeeping
+static atomic_int s_producers_done;
+static int s_last_seq[N_THREADS];
+static size_t s_received[N_THREADS];
+static size_t s_posted[N_THREADS];
+static bool s_in_order;
+
+static void capture_writer(mu_log_level_t level, const char *data, size_t len,
+                           void *arg) {
+    (void)arg;
+    if (s_n_records < 8) {
+        snprintf(s_text[s_n_records], sizeof(s_text[0]), "%.*s", (int)len,
+                 data);
+        s_levels[s_n_records] = level;
+    }
+    s_n_records++;
+}
+
+static void seq_writer(mu_log_level_t level, const char *data, size_t len,
+                       void *arg) {
+    char line[32];
+    int thread, seq;
+
+    (void)level;
+    (void)arg;
+    snprintf(line, sizeof(line), "%.*s", (int)len, data);
+    if (sscanf(line, "t%d %d", &thread, &seq) == 2) {
+        s_in_order = s_in_order && seq > s_last_seq[thread];
+        s_last_seq[thread] = seq;
+        s_received[thread]++;
+    }
+}
+
+static void *producer(void *arg) {
+    int thread = (int)(intptr_t)arg;
+
+    for (int i = 0; i < N_PER_THREAD; i++) {
+        mu_log_span_t span = mu_log_reserve(MU_LOG_LEVEL_INFO, 24);
+        if (span.data != NULL) {
+            int n = snprintf(span.data, span.size, "t%d %d", thread, i);
+            mu_log_commit(span, (size_t)n);
+            s_posted[thread]++;
+        }
+    }
+    atomic_fetch_add(&s_producers_done, 1);
+    return NULL;
+}
+
+static uint64_t fixed_clock(void) {
+    return 42;
+}
+
+static void post(mu_log_level_t level, const char *text) {
+    mu_log_span_t span = mu_log_reserve(level, strlen(text));
+    TEST_ASSERT_NOT_NULL(span.data);
+    memcpy(span.data, text, strlen(text));
+    mu_log_commit(span, strlen(text));
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    memset(s_text, 0, sizeof(s_text));
+    s_n_records = 0;
+    MU_LOG_SET_FN(mu_log_buf_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_DEBUG);
+    TEST_ASSERT_TRUE(mu_log_buf_init(RING_SIZE));
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_buf_init_rejects_bad_sizes(void) {
+    TEST_ASSERT_FALSE(mu_log_buf_init(1000)); // not a power of two
+    TEST_ASSERT_FALSE(mu_log_buf_init(2048)); // ring already allocated
+}
+
+void test_buf_reserve_commit_drain(void) {
+    mu_log_span_t span = mu_log_reserve(MU_LOG_LEVEL_WARN, 40);
+
+    TEST_ASSERT_NOT_NULL(span.data);
+    TEST_ASSERT_TRUE(span.size >= 40);
+    memcpy(span.data, "hello", 5);
+    mu_log_commit(span, 5); // less than reserved
+    post(MU_LOG_LEVEL_INFO, "world");
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_buf_drain(capture_writer, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("hello", s_text[0]);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, s_levels[0]);
+    TEST_ASSERT_EQUAL_STRING("world", s_text[1]);
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_buf_drain(capture_writer, NULL, 0));
+}
+
+void test_buf_drain_waits_for_uncommitted(void) {
+    mu_log_span_t first = mu_log_reserve(MU_LOG_LEVEL_INFO, 8);
+
+    post(MU_LOG_LEVEL_INFO, "second");
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_buf_drain(capture_writer, NULL, 0));
+
+    memcpy(first.data, "first", 5);
+    mu_log_commit(first, 5);
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_buf_drain(capture_writer, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("first", s_text[0]);
+    TEST_ASSERT_EQUAL_STRING("second", s_text[1]);
+}
+
+void test_buf_filtered_and_full(void) {
+    size_t n = 0;
+
+    TEST_ASSERT_NULL(mu_log_reserve(MU_LOG_LEVEL_TRACE, 8).data);
+    TEST_ASSERT_NULL(mu_log_reserve(MU_LOG_LEVEL_INFO, RING_SIZE).data);
+    TEST_ASSERT_EQUAL_size_t(1, mu_log_buf_dropped()); // the oversized one
+
+    for (;;) {
+        mu_log_span_t span = mu_log_reserve(MU_LOG_LEVEL_INFO, 100);
+        if (span.data == NULL) {
+            break;
+        }
+        mu_log_commit(span, 0);
+        n++;
+    }
+    TEST_ASSERT_EQUAL_size_t(RING_SIZE / 128, n);
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_buf_dropped());
+    TEST_ASSERT_EQUAL_size_t(n, mu_log_buf_drain(capture_writer, NULL, 0));
+    TEST_ASSERT_NOT_NULL(mu_log_reserve(MU_LOG_LEVEL_INFO, 100).data);
+}
+
+void test_buf_wraps_around(void) {
+    char text[40];
+
+    for (int i = 0; i < 100; i++) {
+        snprintf(text, sizeof(text), "record %d padded to wrap", i);
+        post(MU_LOG_LEVEL_INFO, text);
+        s_n_records = 0;
+        TEST_ASSERT_EQUAL_size_t(1, mu_log_buf_drain(capture_writer, NULL, 0));
+        TEST_ASSERT_EQUAL_STRING(text, s_text[0]);
+    }
+}
+
+void test_buf_sink_formats_into_ring(void) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_INFO("value=%d", 7);
+    MU_LOG_TRACE("filtered %d", 8);
+    mu_log_buf_drain(capture_writer, NULL, 0);
+    TEST_ASSERT_EQUAL_STRING("value=7", s_text[0]);
+#else
+    MU_LOG_INFO("value");
+    MU_LOG_TRACE("filtered");
+    mu_log_buf_drain(capture_writer, NULL, 0);
+    TEST_ASSERT_EQUAL_STRING("value", s_text[0]);
+#endif
+    TEST_ASSERT_EQUAL_size_t(1, s_n_records);
+}
+
+void test_batch_is_one_record(void) {
+    mu_log_batch_set_clock(fixed_clock);
+    TEST_ASSERT_TRUE(mu_log_batch_begin(MU_LOG_LEVEL_INFO));
+    TEST_ASSERT_FALSE(mu_log_batch_begin(MU_LOG_LEVEL_INFO)); // already open
+#ifdef MU_LOG_ENABLE_FORMATTED
+    TEST_ASSERT_TRUE(mu_log_batch_append("row %d", 0));
+    post(MU_LOG_LEVEL_INFO, "other");
+    TEST_ASSERT_TRUE(mu_log_batch_append("row %d", 1));
+#else
+    TEST_ASSERT_TRUE(mu_log_batch_append("row 0"));
+    post(MU_LOG_LEVEL_INFO, "other");
+    TEST_ASSERT_TRUE(mu_log_batch_append("row 1"));
+#endif
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_buf_drain(capture_writer, NULL, 0));
+    mu_log_batch_end();
+    mu_log_batch_set_clock(NULL);
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_buf_drain(capture_writer, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("batch @42\nrow 0\nrow 1", s_text[0]);
+    TEST_ASSERT_EQUAL_STRING("other", s_text[1]);
+}
+
+void test_batch_filtered_and_overflow(void) {
+    const char *row = "0123456789012345678901234567890123456789";
+    size_t n = 0;
+
+    TEST_ASSERT_FALSE(mu_log_batch_begin(MU_LOG_LEVEL_TRACE));
+    TEST_ASSERT_FALSE(mu_log_batch_append(row));
+    mu_log_batch_end();
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_buf_drain(capture_writer, NULL, 0));
+
+    // a RING_SIZE / 4 (256 byte) batch holds the header and six 41-byte rows
+    TEST_ASSERT_TRUE(mu_log_batch_begin(MU_LOG_LEVEL_INFO));
+    while (mu_log_batch_append(row)) {
+        n++;
+    }
+    TEST_ASSERT_EQUAL_size_t(6, n);
+    TEST_ASSERT_FALSE(mu_log_batch_append(row));
+    mu_log_batch_end();
+    TEST_ASSERT_EQUAL_size_t(1, mu_log_buf_drain(capture_writer, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING_LEN("batch @0\n0123", s_text[0], 13);
+}
+
+void test_buf_concurrent_producers(void) {
+    pthread_t threads[N_THREADS];
+    size_t posted = 0, received = 0;
+
+    s_in_order = true;
+    atomic_store(&s_producers_done, 0);
+    for (int t = 0; t < N_THREADS; t++) {
+        s_last_seq[t] = -1;
+        s_received[t] = 0;
+        s_posted[t] = 0;
+        pthread_create(&threads[t], NULL, producer, (void *)(intptr_t)t);
+    }
+    while (atomic_load(&s_producers_done) < N_THREADS) {
+        mu_log_buf_drain(seq_writer, NULL, 16);
+    }
+    for (int t = 0; t < N_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    mu_log_buf_drain(seq_writer, NULL, 0);
+
+    for (int t = 0; t < N_THREADS; t++) {
+        posted += s_posted[t];
+        received += s_received[t];
+        TEST_ASSERT_EQUAL_size_t(s_posted[t], s_received[t]);
+    }
+    TEST_ASSERT_TRUE(s_in_order);
+    TEST_ASSERT_EQUAL_size_t(N_THREADS * N_PER_THREAD, posted + mu_log_buf_dropped());
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_buf_init_rejects_bad_sizes);
+    RUN_TEST(test_buf_reserve_commit_drain);
+    RUN_TEST(test_buf_drain_waits_for_uncommitted);
+    RUN_TEST(test_buf_filtered_and_full);
+    RUN_TEST(test_buf_wraps_around);
+    RUN_TEST(test_buf_sink_formats_into_ring);
+    RUN_TEST(test_batch_is_one_record);
+    RUN_TEST(test_batch_filtered_and_overflow);
+    RUN_TEST(test_buf_concurrent_producers);
+
+    return UNITY_END();
+}
@@ -0,0 +1,215 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_cfg.c
+ * @brief Unit tests for snapshot-based runtime reconfiguration.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_cfg.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_READERS 2
+#define N_PUBLISHES 20000
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_count_a;
+static int s_count_b;
+static atomic_bool s_stop;
+static atomic_int s_torn;
+static mu_log_module_t s_module = {"db", 0, MU_LOG_LEVEL_TRACE}; // shared
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int sink_a(mu_log_level_t level, const char *format, va_list ap) {
+    (void)level;
+    (void)format;
+    (void)ap;
+    s_count_a++;
+    return 1;
+}
+static int sink_b(mu_log_level_t level, const char *format, va_list ap) {
+    (void)level;
+    (void)format;
+    (void)ap;
+    s_count_b++;
+    return 1;
+}
+#else
+static int sink_a(mu_log_level_t level, const char *message) {
+    (void)level;
+    (void)message;
+    s_count_a++;
+    return 1;
+}
+static int sink_b(mu_log_level_t level, const char *message) {
+    (void)level;
+    (void)message;
+    s_count_b++;
+    return 1;
+}
+#endif
+
+/**
+ * @brief Holds snapshots across a delay, checking that none is rewritten
+ * while held: every sink of a published configuration has the same threshold.
+ * Also refreshes a module cache that the other readers share.
+ */
+static void *reader_thread(void *arg) {
+    int reader = mu_log_cfg_register_reader();
+
+    (void)arg;
+    while (!atomic_load(&s_stop)) {
+        const mu_log_config_t *config = mu_log_cfg_current();
+        mu_log_level_t first = config->sinks[0].threshold;
+
+        mu_log_module_will_log(&s_module, MU_LOG_LEVEL_INFO);
+        sched_yield(); // let the publisher run while the snapshot is held
+        for (size_t i = 0; i < config->n_sinks; i++) {
+            if (config->sinks[i].threshold != first) {
+                atomic_fetch_add(&s_torn, 1);
+            }
+        }
+        mu_log_cfg_quiescent(reader);
+    }
+    mu_log_cfg_unregister_reader(reader);
+    return NULL;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    s_count_a = 0;
+    s_count_b = 0;
+    TEST_ASSERT_TRUE(mu_log_cfg_init());
+    MU_LOG_SET_FN(mu_log_cfg_fn);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_cfg_fans_out_by_sink_threshold(void) {
+    mu_log_config_t config = {
+        2, {{sink_a, MU_LOG_LEVEL_DEBUG}, {sink_b, MU_LOG_LEVEL_ERROR}}};
+
+    MU_LOG_ERROR("before");
+    TEST_ASSERT_EQUAL_INT(0, s_count_a + s_count_b); // empty configuration
+
+    TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_DEBUG, MU_LOG_GET_THRESHOLD());
+    MU_LOG_TRACE("neither");
+    MU_LOG_DEBUG("a only");
+    MU_LOG_ERROR("both");
+    TEST_ASSERT_EQUAL_INT(2, s_count_a);
+    TEST_ASSERT_EQUAL_INT(1, s_count_b);
+
+    config.n_sinks = MU_LOG_CFG_MAX_SINKS + 1;
+    TEST_ASSERT_FALSE(mu_log_cfg_publish(&config));
+}
+
+void test_cfg_init_keeps_threshold(void) {
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_WARN);
+    TEST_ASSERT_TRUE(mu_log_cfg_init());
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, MU_LOG_GET_THRESHOLD());
+    MU_LOG_SET_THRESHOLD(MU_LOG_DEFAULT_LEVEL);
+}
+
+void test_cfg_reclaims_after_quiescent_state(void) {
+    mu_log_config_t config = {1, {{sink_a, MU_LOG_LEVEL_INFO}}};
+    int reader = mu_log_cfg_register_reader();
+
+    TEST_ASSERT_TRUE(reader >= 0);
+    // the initial snapshot is current; the other snapshots can be published
+    // while the reader holds on to each one retired
+    for (int i = 1; i < MU_LOG_CFG_SNAPSHOTS; i++) {
+        TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+    }
+    TEST_ASSERT_FALSE(mu_log_cfg_publish(&config));
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_cfg_reclaim());
+
+    mu_log_cfg_quiescent(reader);
+    TEST_ASSERT_EQUAL_size_t(MU_LOG_CFG_SNAPSHOTS - 1, mu_log_cfg_reclaim());
+    TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+
+    // unregistered readers do not hold back reclamation
+    mu_log_cfg_unregister_reader(reader);
+    for (int i = 0; i < 2 * MU_LOG_CFG_SNAPSHOTS; i++) {
+        TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+    }
+}
+
+void test_cfg_concurrent_publish(void) {
+    pthread_t threads[N_READERS];
+    mu_log_config_t config;
+    int published = 0;
+
+    atomic_store(&s_stop, false);
+    atomic_store(&s_torn, 0);
+    for (int t = 0; t < N_READERS; t++) {
+        pthread_create(&threads[t], NULL, reader_thread, NULL);
+    }
+    for (int i = 0; i < N_PUBLISHES; i++) {
+        memset(&config, 0, sizeof(config));
+        config.n_sinks = MU_LOG_CFG_MAX_SINKS;
+        for (int s = 0; s < MU_LOG_CFG_MAX_SINKS; s++) {
+            config.sinks[s].fn = sink_a;
+            config.sinks[s].threshold = (mu_log_level_t)(i % 6);
+        }
+        published += mu_log_cfg_publish(&config) ? 1 : 0;
+        if (i % 8 == 0) {
+            sched_yield();
+        }
+    }
+    atomic_store(&s_stop, true);
+    for (int t = 0; t < N_READERS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&s_torn));
+    TEST_ASSERT_TRUE(published > 0);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_cfg_fans_out_by_sink_threshold);
+    RUN_TEST(test_cfg_init_keeps_threshold);
+    RUN_TEST(test_cfg_reclaims_after_quiescent_state);
+    RUN_TEST(test_cfg_concurrent_publish);
+
+    return UNITY_END();
+}
@@ -0,0 +1,216 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_cpp.cpp
+ * @brief Unit tests for the C++ pipeline layer (mu_log.hpp).
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.hpp"
+#include "unity.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+// *****************************************************************************
+// Private types and storage
+
+namespace {
+
+char s_lines[4][MU_LOG_CPP_LINE_MAX];
+mu_log_level_t s_levels[4];
+int s_n_lines;
+
+/** Sink that records up to four lines. */
+struct capture_sink {
+    void write(mu_log_level_t level, const char *line, size_t len) {
+        if (s_n_lines < 4) {
+            std::memcpy(s_lines[s_n_lines], line, len);
+            s_lines[s_n_lines][len] = '\0';
+            s_levels[s_n_lines] = level;
+        }
+        s_n_lines++;
+    }
+};
+
+/** A second sink, to check that every sink receives the line. */
+struct counting_sink {
+    void write(mu_log_level_t, const char *, size_t) { calls++; }
+    int calls = 0;
+};
+
+using text_log = mu::pipeline<mu::level_filter<MU_LOG_LEVEL_INFO>,
+                              mu::text_format, capture_sink, counting_sink>;
+using json_log = mu::pipeline<mu::json_format, capture_sink>;
+using raw_log = mu::pipeline<capture_sink>;
+using limited_log = mu::pipeline<mu::rate_limit<2>, capture_sink>;
+
+} // namespace
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    std::memset(s_lines, 0, sizeof(s_lines));
+    s_n_lines = 0;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_format_to_placeholders(void) {
+    char buf[96];
+    int local = 0;
+    size_t n = mu::format_to(buf, sizeof(buf), "{} {} {} {} {} {{}} {}", -42,
+                             18446744073709551615ull, "str", 'c', true, 2.5);
+    TEST_ASSERT_EQUAL_STRING("-42 18446744073709551615 str c true {} 2.5", buf);
+    TEST_ASSERT_EQUAL_size_t(std::strlen(buf), n);
+
+    mu::format_to(buf, sizeof(buf), "{}", (void *)&local);
+    TEST_ASSERT_EQUAL_STRING_LEN("0x", buf, 2);
+
+    mu::format_to(buf, sizeof(buf), "missing {} {}", 1);
+    TEST_ASSERT_EQUAL_STRING("missing 1 ", buf);
+    mu::format_to(buf, sizeof(buf), "extra", 1, 2);
+    TEST_ASSERT_EQUAL_STRING("extra", buf);
+}
+
+void test_format_to_truncates(void) {
+    char buf[8];
+    size_t n = mu::format_to(buf, sizeof(buf), "{}-{}", "abcdef", 1234);
+    TEST_ASSERT_EQUAL_STRING("abcdef-", buf);
+    TEST_ASSERT_EQUAL_size_t(7, n);
+}
+
+void test_pipeline_filters_formats_and_fans_out(void) {
+    text_log log;
+
+    log.debug("hidden {}", 1);
+    log.warn("disk {}% full", 93);
+
+    TEST_ASSERT_EQUAL_INT(1, s_n_lines);
+    TEST_ASSERT_EQUAL_STRING("WARN: disk 93% full", s_lines[0]);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, s_levels[0]);
+    TEST_ASSERT_EQUAL_INT(1, log.get<counting_sink>().calls);
+    TEST_ASSERT_FALSE(log.will_log(MU_LOG_LEVEL_DEBUG));
+}
+
+void test_pipeline_json_format_escapes(void) {
+    json_log log;
+
+    log.error("say \"{}\"\n", "hi");
+    TEST_ASSERT_EQUAL_STRING("{\"level\":\"ERROR\",\"msg\":\"say \\\"hi\\\"\\n\"}",
+                             s_lines[0]);
+}
+
+void test_pipeline_json_format_truncates_whole(void) {
+    json_log log;
+    char msg[MU_LOG_CPP_LINE_MAX];
+    size_t n;
+
+    // every byte escapes to \u0001, so the cut falls mid-escape unless
+    // whole escapes are kept
+    std::memset(msg, 0x01, sizeof(msg));
+    log.emit(MU_LOG_LEVEL_INFO, msg, sizeof(msg));
+    n = std::strlen(s_lines[0]);
+    TEST_ASSERT_TRUE(n < MU_LOG_CPP_LINE_MAX);
+    TEST_ASSERT_EQUAL_STRING("\"}", &s_lines[0][n - 2]);
+    TEST_ASSERT_EQUAL_STRING_LEN("\\u0001\"}", &s_lines[0][n - 8], 8);
+}
+
+void test_pipeline_without_formatter_writes_message(void) {
+    raw_log log;
+
+    log.info("plain {}", 7);
+    TEST_ASSERT_EQUAL_STRING("plain 7", s_lines[0]);
+}
+
+void test_pipeline_rate_limit(void) {
+    limited_log log;
+
+    for (int i = 0; i < 5; i++) {
+        log.info("burst {}", i);
+    }
+    TEST_ASSERT_EQUAL_INT(2, s_n_lines);
+    TEST_ASSERT_EQUAL_size_t(3, log.get<mu::rate_limit<2>>().dropped);
+}
+
+void test_rate_limit_shared_between_threads(void) {
+    static mu::rate_limit<100> limit;
+    std::atomic<size_t> accepted{0};
+    std::thread threads[4];
+
+    for (auto &t : threads) {
+        t = std::thread([&] {
+            for (int i = 0; i < 20000; i++) {
+                if (limit.accept(MU_LOG_LEVEL_INFO)) {
+                    accepted++;
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    // every call is either let through or counted, and the burst holds
+    TEST_ASSERT_EQUAL_size_t(80000, accepted + limit.dropped);
+    TEST_ASSERT_TRUE(accepted >= 100);
+}
+
+void test_install_routes_c_logging(void) {
+    mu::install<text_log>();
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_TRACE);
+
+    MU_LOG_DEBUG("from C, filtered by the pipeline");
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_ERROR("from C: %d", 5);
+    TEST_ASSERT_EQUAL_STRING("ERROR: from C: 5", s_lines[0]);
+#else
+    MU_LOG_ERROR("from C");
+    TEST_ASSERT_EQUAL_STRING("ERROR: from C", s_lines[0]);
+#endif
+    TEST_ASSERT_EQUAL_INT(1, s_n_lines);
+    TEST_ASSERT_EQUAL_INT(1, mu::instance<text_log>().get<counting_sink>().calls);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_format_to_placeholders);
+    RUN_TEST(test_format_to_truncates);
+    RUN_TEST(test_pipeline_filters_formats_and_fans_out);
+    RUN_TEST(test_pipeline_json_format_escapes);
+    RUN_TEST(test_pipeline_json_format_truncates_whole);
+    RUN_TEST(test_pipeline_without_formatter_writes_message);
+    RUN_TEST(test_pipeline_rate_limit);
+    RUN_TEST(test_rate_limit_shared_between_threads);
+    RUN_TEST(test_install_routes_c_logging);
+
+    return UNITY_END();
+}
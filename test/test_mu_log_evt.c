@@ -0,0 +1,155 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_evt.c
+ * @brief Unit tests for event-loop draining, driven by a real epoll set.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_evt.h"
+#include "unity.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_SIZE 4096
+#define N_RECORDS 8
+#define TEXT_MAX 32
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static char s_text[N_RECORDS][TEXT_MAX];
+static size_t s_n_records;
+static int s_epoll = -1;
+static int s_fd = -1;
+
+static void capture_writer(mu_log_level_t level, const char *data, size_t len,
+                           void *arg) {
+    (void)level;
+    (void)arg;
+    if (s_n_records < N_RECORDS) {
+        snprintf(s_text[s_n_records], TEXT_MAX, "%.*s", (int)len, data);
+        s_n_records++;
+    }
+}
+
+/**
+ * @brief True if the epoll set reports the log descriptor readable.
+ */
+static bool loop_ready(void) {
+    struct epoll_event event;
+    return epoll_wait(s_epoll, &event, 1, 0) == 1 && event.data.fd == s_fd;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    struct epoll_event event = {.events = EPOLLIN};
+
+    memset(s_text, 0, sizeof(s_text));
+    s_n_records = 0;
+    TEST_ASSERT_TRUE(mu_log_buf_init(RING_SIZE));
+    s_fd = mu_log_evt_init(capture_writer, NULL);
+    TEST_ASSERT_TRUE(s_fd >= 0);
+    s_epoll = epoll_create1(0);
+    event.data.fd = s_fd;
+    TEST_ASSERT_EQUAL_INT(0, epoll_ctl(s_epoll, EPOLL_CTL_ADD, s_fd, &event));
+    MU_LOG_SET_FN(mu_log_evt_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_DEBUG);
+}
+
+void tearDown(void) {
+    close(s_epoll);
+    mu_log_evt_close();
+}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_evt_records_wait_for_the_loop(void) {
+    TEST_ASSERT_FALSE(loop_ready());
+    MU_LOG_INFO("one");
+    MU_LOG_INFO("two");
+    TEST_ASSERT_EQUAL_size_t(0, s_n_records);
+    TEST_ASSERT_TRUE(loop_ready());
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_evt_drain(0));
+    TEST_ASSERT_EQUAL_STRING("one", s_text[0]);
+    TEST_ASSERT_EQUAL_STRING("two", s_text[1]);
+    TEST_ASSERT_FALSE(loop_ready());
+}
+
+void test_evt_signals_once_per_drain(void) {
+    uint64_t count = 0;
+
+    for (int i = 0; i < 5; i++) {
+        MU_LOG_INFO("burst");
+    }
+    TEST_ASSERT_EQUAL_INT(sizeof(count), read(s_fd, &count, sizeof(count)));
+    TEST_ASSERT_EQUAL_UINT64(1, count);
+    TEST_ASSERT_EQUAL_size_t(5, mu_log_evt_drain(0));
+
+    MU_LOG_INFO("again");
+    TEST_ASSERT_TRUE(loop_ready());
+}
+
+void test_evt_budget_bounds_each_iteration(void) {
+    for (int i = 0; i < 5; i++) {
+        MU_LOG_INFO("record");
+    }
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_evt_drain(2));
+    TEST_ASSERT_TRUE(loop_ready()); // the rest re-arms the loop
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_evt_drain(2));
+    TEST_ASSERT_TRUE(loop_ready());
+    TEST_ASSERT_EQUAL_size_t(1, mu_log_evt_drain(2));
+    TEST_ASSERT_FALSE(loop_ready());
+    TEST_ASSERT_EQUAL_size_t(5, s_n_records);
+}
+
+void test_evt_filtered_records_stay_out(void) {
+    MU_LOG_TRACE("filtered");
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_evt_drain(0));
+    TEST_ASSERT_EQUAL_size_t(0, s_n_records);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_evt_records_wait_for_the_loop);
+    RUN_TEST(test_evt_signals_once_per_drain);
+    RUN_TEST(test_evt_budget_bounds_each_iteration);
+    RUN_TEST(test_evt_filtered_records_stay_out);
+
+    return UNITY_END();
+}
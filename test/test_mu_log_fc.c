@@ -0,0 +1,210 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_fc.c
+ * @brief Unit tests for the flat-combining synchronous sink.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_fc.h"
+#include "unity.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_THREADS 4
+#define N_LINES 2000
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+#define PREFIX " INFO: "
+#else
+#define PREFIX "INFO: "
+#endif
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_pipe[2];
+static size_t s_lines;
+static size_t s_writes;
+
+/**
+ * @brief Reads what is in the pipe, without blocking.
+ */
+static size_t read_pipe(char *buf, size_t size) {
+    ssize_t n = read(s_pipe[0], buf, size - 1);
+
+    n = n < 0 ? 0 : n;
+    buf[n] = '\0';
+    return (size_t)n;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int call_sink(mu_log_level_t level, const char *format, ...) {
+    va_list ap;
+    int n;
+
+    va_start(ap, format);
+    n = mu_log_fc_fn(level, format, ap);
+    va_end(ap);
+    return n;
+}
+#endif
+
+/**
+ * @brief Logs `text` through the sink directly, returning its result.
+ */
+static int log_text(const char *text) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    return call_sink(MU_LOG_LEVEL_INFO, "%s", text);
+#else
+    return mu_log_fc_fn(MU_LOG_LEVEL_INFO, text);
+#endif
+}
+
+static void *log_thread(void *arg) {
+    (void)arg;
+    for (int i = 0; i < N_LINES; i++) {
+        MU_LOG_INFO("worker");
+    }
+    return NULL;
+}
+
+/**
+ * @brief Reads lines until N_THREADS * N_LINES arrive; returns the number of
+ * malformed ones.
+ */
+static void *read_thread(void *arg) {
+    static const char line[] = PREFIX "worker\n";
+    size_t expected = N_THREADS * N_LINES * (sizeof(line) - 1);
+    size_t offset = 0;
+    size_t *bad = (size_t *)arg;
+    char buf[4096];
+
+    *bad = 0;
+    while (offset < expected) {
+        ssize_t n = read(s_pipe[0], buf, sizeof(buf));
+        if (n <= 0) {
+            continue;
+        }
+        for (ssize_t i = 0; i < n; i++, offset++) {
+            *bad += buf[i] != line[offset % (sizeof(line) - 1)];
+        }
+    }
+    return NULL;
+}
+
+static void take_stats(void) {
+    mu_log_fc_stats(&s_lines, &s_writes);
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    TEST_ASSERT_EQUAL_INT(0, pipe(s_pipe));
+    TEST_ASSERT_TRUE(mu_log_fc_init(s_pipe[1]));
+    MU_LOG_SET_FN(mu_log_fc_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+void tearDown(void) {
+    close(s_pipe[0]);
+    close(s_pipe[1]);
+}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_fc_writes_lines_in_order(void) {
+    char buf[256];
+
+    fcntl(s_pipe[0], F_SETFL, O_NONBLOCK);
+    MU_LOG_INFO("one");
+    MU_LOG_DEBUG("filtered");
+    MU_LOG_INFO("two");
+    read_pipe(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING(PREFIX "one\n" PREFIX "two\n", buf);
+    take_stats();
+    TEST_ASSERT_EQUAL_size_t(2, s_lines);
+    TEST_ASSERT_EQUAL_size_t(2, s_writes);
+}
+
+void test_fc_truncates_long_lines(void) {
+    char message[2 * MU_LOG_FC_LINE_MAX];
+    char buf[4 * MU_LOG_FC_LINE_MAX];
+
+    memset(message, 'x', sizeof(message) - 1);
+    message[sizeof(message) - 1] = '\0';
+    fcntl(s_pipe[0], F_SETFL, O_NONBLOCK);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_FC_LINE_MAX, log_text(message));
+    TEST_ASSERT_EQUAL_size_t(MU_LOG_FC_LINE_MAX, read_pipe(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_CHAR('\n', buf[MU_LOG_FC_LINE_MAX - 1]);
+}
+
+void test_fc_reports_write_failure(void) {
+    close(s_pipe[0]); // EPIPE from now on
+    signal(SIGPIPE, SIG_IGN);
+    TEST_ASSERT_EQUAL_INT(-1, log_text("lost"));
+    s_pipe[0] = open("/dev/null", O_RDONLY); // for tearDown
+}
+
+void test_fc_concurrent_lines_are_whole(void) {
+    pthread_t loggers[N_THREADS];
+    pthread_t reader;
+    size_t bad;
+
+    take_stats();
+    pthread_create(&reader, NULL, read_thread, &bad);
+    for (int t = 0; t < N_THREADS; t++) {
+        pthread_create(&loggers[t], NULL, log_thread, NULL);
+    }
+    for (int t = 0; t < N_THREADS; t++) {
+        pthread_join(loggers[t], NULL);
+    }
+    pthread_join(reader, NULL);
+    TEST_ASSERT_EQUAL_size_t(0, bad);
+    take_stats();
+    TEST_ASSERT_EQUAL_size_t(N_THREADS * N_LINES, s_lines);
+    TEST_ASSERT_TRUE(s_writes <= s_lines);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fc_writes_lines_in_order);
+    RUN_TEST(test_fc_truncates_long_lines);
+    RUN_TEST(test_fc_reports_write_failure);
+    RUN_TEST(test_fc_concurrent_lines_are_whole);
+
+    return UNITY_END();
+}
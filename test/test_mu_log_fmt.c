@@ -0,0 +1,249 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_fmt.c
+ * @brief Unit tests for the stdio-free formatter, checked against snprintf().
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_fmt.h"
+#include "unity.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static char s_out[128];
+static size_t s_out_len;
+
+static void capture_putc(char ch, void *arg) {
+    (void)arg;
+    if (s_out_len + 1 < sizeof(s_out)) {
+        s_out[s_out_len++] = ch;
+        s_out[s_out_len] = '\0';
+    }
+}
+
+/**
+ * @brief Asserts that mu_log_fmt_snprintf() agrees with the C library.
+ */
+static void check_against_libc(const char *format, ...) {
+    char expected[128];
+    char actual[128];
+    va_list ap, ap2;
+    int n_expected, n_actual;
+
+    va_start(ap, format);
+    va_copy(ap2, ap);
+    n_expected = vsnprintf(expected, sizeof(expected), format, ap);
+    n_actual = mu_log_fmt_vsnprintf(actual, sizeof(actual), format, ap2);
+    va_end(ap2);
+    va_end(ap);
+
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, format);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(n_expected, n_actual, format);
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    s_out[0] = '\0';
+    s_out_len = 0;
+    mu_log_set_putc(capture_putc, NULL);
+    MU_LOG_SET_FN(mu_log_putc_fn);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_fmt_literals_and_percent(void) {
+    check_against_libc("plain text");
+    check_against_libc("100%% sure");
+    check_against_libc("");
+}
+
+void test_fmt_signed(void) {
+    check_against_libc("%d %i", 42, -42);
+    check_against_libc("%d", INT32_MIN);
+    check_against_libc("[%5d] [%-5d] [%05d]", -12, -12, -12);
+    check_against_libc("%ld %lld", -123456789L, (long long)INT64_MIN);
+    check_against_libc("%zd", (size_t)77);
+    check_against_libc("%hd %hhd", 7, 3);
+    check_against_libc("%hd %hhd", 40000, 200); // narrowed: -25536 -56
+}
+
+void test_fmt_unsigned_and_hex(void) {
+    check_against_libc("%u", 4000000000u);
+    check_against_libc("%x %X", 0xbeefu, 0xbeefu);
+    check_against_libc("[%08x] [%-8x] [%8X]", 0x1234u, 0x1234u, 0x1234u);
+    check_against_libc("%llx", 0xfedcba9876543210ull);
+    check_against_libc("%zu %lu", (size_t)SIZE_MAX, 0ul);
+    check_against_libc("%*d|%-*d", 6, 1, 6, 2);
+    check_against_libc("%hhu %hu %hhx", 300, 70000, 0x1ff);
+}
+
+void test_fmt_strings_and_chars(void) {
+    check_against_libc("%s, %s!", "hello", "world");
+    check_against_libc("[%8s] [%-8s] [%.3s]", "abc", "abc", "abcdef");
+    check_against_libc("%c%c%c", 'm', 'u', '!');
+    check_against_libc("[%3c]", 'x');
+}
+
+void test_fmt_pointer(void) {
+    int x;
+    check_against_libc("%p", (void *)&x);
+    check_against_libc("[%20p] [%-20p]", (void *)&x, (void *)&x);
+}
+
+void test_fmt_unsupported_is_echoed(void) {
+    char buf[32];
+    mu_log_fmt_snprintf(buf, sizeof(buf), "%f|%q", 1.0);
+    TEST_ASSERT_EQUAL_STRING("%f|%q", buf);
+    mu_log_fmt_snprintf(buf, sizeof(buf), "trailing %");
+    TEST_ASSERT_EQUAL_STRING("trailing %", buf);
+
+    // a floating-point argument is skipped, not misread as the next one
+    mu_log_fmt_snprintf(buf, sizeof(buf), "t=%.2f %Lg %s", 1.5,
+                        (long double)2.5, "ok");
+    TEST_ASSERT_EQUAL_STRING("t=%.2f %Lg ok", buf);
+}
+
+void test_fmt_snprintf_truncates(void) {
+    char buf[8];
+    int n = mu_log_fmt_snprintf(buf, sizeof(buf), "%s-%d", "abcdef", 1234);
+    TEST_ASSERT_EQUAL_STRING("abcdef-", buf);
+    TEST_ASSERT_EQUAL_INT(11, n);
+
+    // a length probe writes nothing
+    TEST_ASSERT_EQUAL_INT(11, mu_log_fmt_snprintf(NULL, 0, "%s-%d", "abcdef",
+                                                  1234));
+}
+
+void test_fmt_words(void) {
+    char buf[64];
+    const uintptr_t words[] = {(uintptr_t)-5, 0x1ffu, (uintptr_t)"ok", 6, 'z'};
+
+    mu_log_fmt_wsnprintf(buf, sizeof(buf), "%d %x %s|%*c|%d", words, 5);
+    TEST_ASSERT_EQUAL_STRING("-5 1ff ok|     z|0", buf);
+
+    mu_log_fmt_wsnprintf(buf, sizeof(buf), "%hhu %hd", words, 2);
+    TEST_ASSERT_EQUAL_STRING("251 511", buf);
+}
+
+void test_fmt_builtin_conversions(void) {
+    static const uint8_t v6[16] = {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                   0, 0, 0, 0, 0, 0, 0, 0x01};
+    static const uint8_t uuid[16] = {0x12, 0x3e, 0x45, 0x67, 0xe8, 0x9b,
+                                     0x12, 0xd3, 0xa4, 0x56, 0x42, 0x66,
+                                     0x14, 0x17, 0x40, 0x00};
+    char buf[96];
+
+    TEST_ASSERT_TRUE(mu_log_fmt_register_builtins());
+    mu_log_fmt_snprintf(buf, sizeof(buf), "%{ipv4}|%-12{ipv4}|",
+                        (uintptr_t)0xc0a80001u, (uintptr_t)0x0a000002u);
+    TEST_ASSERT_EQUAL_STRING("192.168.0.1|10.0.0.2    |", buf);
+    mu_log_fmt_snprintf(buf, sizeof(buf), "%{ipv6} %{uuid}", (uintptr_t)v6,
+                        (uintptr_t)uuid);
+    TEST_ASSERT_EQUAL_STRING(
+        "2001:db8::1 123e4567-e89b-12d3-a456-426614174000", buf);
+    mu_log_fmt_snprintf(buf, sizeof(buf), "%{dur_ns} %{dur_ns} %{dur_ns}",
+                        (uintptr_t)999, (uintptr_t)1500000,
+                        (uintptr_t)2000000000u);
+    TEST_ASSERT_EQUAL_STRING("999ns 1.500ms 2.000s", buf);
+
+    // A short buffer truncates the text instead of overrunning it
+    memset(buf, '#', sizeof(buf));
+    TEST_ASSERT_EQUAL(8, mu_log_fmt_uuid(buf, 8, (uintptr_t)uuid));
+    TEST_ASSERT_EQUAL_MEMORY("123e4567#", buf, 9);
+    memset(buf, '#', sizeof(buf));
+    TEST_ASSERT_EQUAL(4, mu_log_fmt_ipv6(buf, 4, (uintptr_t)v6));
+    TEST_ASSERT_EQUAL_MEMORY("2001#", buf, 5);
+}
+
+static size_t render_ms(char *buf, size_t size, uintptr_t value) {
+    return (size_t)mu_log_fmt_snprintf(buf, size, "%ums", (unsigned)value);
+}
+
+void test_fmt_registered_conversion(void) {
+    const uintptr_t words[] = {250, 99, 7};
+    char buf[64];
+
+    TEST_ASSERT_TRUE(mu_log_fmt_register("ms", render_ms));
+    mu_log_fmt_wsnprintf(buf, sizeof(buf), "took %{ms}, %{nope} %d", words, 3);
+    // an unknown name is echoed but consumes its argument
+    TEST_ASSERT_EQUAL_STRING("took 250ms, %{nope} 7", buf);
+    mu_log_fmt_snprintf(buf, sizeof(buf), "open %{ms", (uintptr_t)1);
+    TEST_ASSERT_EQUAL_STRING("open %{ms", buf);
+}
+
+void test_putc_fn_writes_line(void) {
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_INFO("value=%d", 7);
+    TEST_ASSERT_EQUAL_STRING(" INFO: value=7\n", s_out);
+#else
+    MU_LOG_INFO("hello");
+    TEST_ASSERT_EQUAL_STRING("INFO: hello\n", s_out);
+#endif
+}
+
+void test_putc_fn_respects_threshold(void) {
+    MU_LOG_DEBUG("hidden");
+    TEST_ASSERT_EQUAL_size_t(0, s_out_len);
+}
+
+void test_putc_fn_without_hook_is_silent(void) {
+    mu_log_set_putc(NULL, NULL);
+    MU_LOG_ERROR("nowhere to go");
+    TEST_ASSERT_EQUAL_size_t(0, s_out_len);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fmt_literals_and_percent);
+    RUN_TEST(test_fmt_signed);
+    RUN_TEST(test_fmt_unsigned_and_hex);
+    RUN_TEST(test_fmt_strings_and_chars);
+    RUN_TEST(test_fmt_pointer);
+    RUN_TEST(test_fmt_unsupported_is_echoed);
+    RUN_TEST(test_fmt_snprintf_truncates);
+    RUN_TEST(test_fmt_words);
+    RUN_TEST(test_fmt_builtin_conversions);
+    RUN_TEST(test_fmt_registered_conversion);
+    RUN_TEST(test_putc_fn_writes_line);
+    RUN_TEST(test_putc_fn_respects_threshold);
+    RUN_TEST(test_putc_fn_without_hook_is_silent);
+
+    return UNITY_END();
+}
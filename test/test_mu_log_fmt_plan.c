@@ -0,0 +1,185 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_fmt_plan.c
+ * @brief Unit tests for the formatter's render-plan cache.
+ *
+ * Built, with the library, with a four-plan cache of up to eight steps each.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_fmt.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_THREADS 2
+#define N_RENDERS 20000
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static size_t s_hits;
+static size_t s_misses;
+
+/**
+ * @brief Asserts that mu_log_fmt_snprintf() agrees with the C library.
+ */
+static void check_against_libc(const char *format, ...) {
+    char expected[128];
+    char actual[128];
+    va_list ap, ap2;
+
+    va_start(ap, format);
+    va_copy(ap2, ap);
+    vsnprintf(expected, sizeof(expected), format, ap);
+    mu_log_fmt_vsnprintf(actual, sizeof(actual), format, ap2);
+    va_end(ap2);
+    va_end(ap);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, format);
+}
+
+/**
+ * @brief Asserts the hits and misses since the last call.
+ */
+static void check_stats(size_t hits, size_t misses) {
+    size_t total_hits, total_misses;
+
+    mu_log_fmt_plan_stats(&total_hits, &total_misses);
+    TEST_ASSERT_EQUAL_size_t(hits, total_hits - s_hits);
+    TEST_ASSERT_EQUAL_size_t(misses, total_misses - s_misses);
+    s_hits = total_hits;
+    s_misses = total_misses;
+}
+
+static void *render_thread(void *arg) {
+    static const char *const formats[N_THREADS] = {"t0 %d/%s", "t1 %5u|%x"};
+    int t = *(int *)arg;
+    int errors = 0;
+
+    for (int i = 0; i < N_RENDERS; i++) {
+        char expected[32];
+        char actual[32];
+        if (t == 0) {
+            snprintf(expected, sizeof(expected), formats[t], i, "x");
+            mu_log_fmt_snprintf(actual, sizeof(actual), formats[t], i, "x");
+        } else {
+            snprintf(expected, sizeof(expected), formats[t], i, i);
+            mu_log_fmt_snprintf(actual, sizeof(actual), formats[t], i, i);
+        }
+        errors += strcmp(expected, actual) != 0;
+    }
+    *(int *)arg = errors;
+    return NULL;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    mu_log_fmt_plan_stats(&s_hits, &s_misses);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_plan_is_built_once_and_replayed(void) {
+    static const char format[] = "id=%-4d hex=%08lx name=%.3s%%";
+
+    check_against_libc(format, 7, 0xbeefL, "abcdef");
+    check_stats(0, 1);
+    check_against_libc(format, -12, 0x1L, "x");
+    check_against_libc(format, 0, 0L, "");
+    check_stats(2, 0);
+}
+
+void test_plan_replays_star_fields_and_echoes(void) {
+    static const char format[] = "[%*d] [%-*s] %q %{nope}";
+    uintptr_t words[] = {5, 42, (uintptr_t)-4, (uintptr_t) "ab", 0};
+    char out[64];
+
+    for (int i = 0; i < 2; i++) {
+        mu_log_fmt_wsnprintf(out, sizeof(out), format, words, 5);
+        TEST_ASSERT_EQUAL_STRING("[   42] [ab  ] %q %{nope}", out);
+    }
+    check_stats(1, 1);
+}
+
+void test_plan_long_formats_are_not_cached(void) {
+    static const char format[] = "%d %d %d %d %d"; // nine steps
+
+    for (int i = 0; i < 2; i++) {
+        check_against_libc(format, 1, 2, 3, 4, 5);
+    }
+    check_stats(0, 2);
+}
+
+void test_plan_concurrent_renders(void) {
+    pthread_t threads[N_THREADS];
+    int results[N_THREADS];
+
+    for (int t = 0; t < N_THREADS; t++) {
+        results[t] = t;
+        pthread_create(&threads[t], NULL, render_thread, &results[t]);
+    }
+    for (int t = 0; t < N_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        TEST_ASSERT_EQUAL_INT(0, results[t]);
+    }
+    check_stats(2 * (N_RENDERS - 1), 2); // one plan per thread's format
+}
+
+void test_plan_full_cache_falls_back_to_parsing(void) {
+    static const char *const formats[] = {"a%d", "b%d"};
+
+    // all four plans are taken by the tests above
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 2; i++) {
+            check_against_libc(formats[i], round);
+        }
+    }
+    check_stats(0, 4);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_plan_is_built_once_and_replayed);
+    RUN_TEST(test_plan_replays_star_fields_and_echoes);
+    RUN_TEST(test_plan_long_formats_are_not_cached);
+    RUN_TEST(test_plan_concurrent_renders);
+    RUN_TEST(test_plan_full_cache_falls_back_to_parsing);
+
+    return UNITY_END();
+}
@@ -0,0 +1,281 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_isr.c
+ * @brief Unit tests for interrupt-safe deferred logging.
+ *
+ * POSIX signals stand in for interrupts: a SIGALRM handler driven by
+ * `setitimer()` posts records while the main context posts and drains, so
+ * producers interrupt each other and the drain at arbitrary points.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_isr.h"
+#include "unity.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define LINE_MAX_LEN 64
+#define N_LINES 64
+#define HAMMER_MS 200
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static char s_lines[N_LINES][LINE_MAX_LEN];
+static mu_log_level_t s_levels[N_LINES];
+static size_t s_n_lines;
+
+// Hammer bookkeeping
+static volatile sig_atomic_t s_isr_posted;
+static unsigned s_isr_next;
+static size_t s_isr_received;
+static size_t s_main_received;
+static long s_isr_last;
+static long s_main_last;
+static bool s_in_order;
+
+static void record_line(mu_log_level_t level, const char *line) {
+    if (s_n_lines < N_LINES) {
+        snprintf(s_lines[s_n_lines], LINE_MAX_LEN, "%s", line);
+        s_levels[s_n_lines] = level;
+        s_n_lines++;
+    }
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int capture_sink(mu_log_level_t level, const char *format, va_list ap) {
+    char line[LINE_MAX_LEN];
+    if (!MU_LOG_WILL_LOG(level)) {
+        return 0;
+    }
+    vsnprintf(line, sizeof(line), format, ap);
+    record_line(level, line);
+    return 1;
+}
+#else
+static int capture_sink(mu_log_level_t level, const char *message) {
+    if (!MU_LOG_WILL_LOG(level)) {
+        return 0;
+    }
+    record_line(level, message);
+    return 1;
+}
+#endif
+
+/**
+ * @brief Checks that each source's sequence numbers arrive in order.
+ */
+static void check_line(const char *line) {
+    unsigned seq;
+
+    if (sscanf(line, "isr %u", &seq) == 1) {
+        s_in_order = s_in_order && (long)seq > s_isr_last;
+        s_isr_last = seq;
+        s_isr_received++;
+    } else if (sscanf(line, "main %u", &seq) == 1) {
+        s_in_order = s_in_order && (long)seq > s_main_last;
+        s_main_last = seq;
+        s_main_received++;
+    }
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int hammer_sink(mu_log_level_t level, const char *format, va_list ap) {
+    char line[LINE_MAX_LEN];
+    (void)level;
+    vsnprintf(line, sizeof(line), format, ap);
+    check_line(line);
+    return 1;
+}
+#else
+static int hammer_sink(mu_log_level_t level, const char *message) {
+    (void)level;
+    check_line(message);
+    return 1;
+}
+#endif
+
+static void alarm_handler(int sig) {
+    (void)sig;
+    if (MU_LOG_ISR(MU_LOG_LEVEL_INFO, "isr %u", s_isr_next)) {
+        s_isr_posted++;
+    }
+    s_isr_next++;
+}
+
+static long elapsed_ms(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000 +
+           (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    memset(s_lines, 0, sizeof(s_lines));
+    s_n_lines = 0;
+    MU_LOG_SET_FN(capture_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_TRACE);
+    mu_log_isr_init();
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_isr_post_is_deferred_until_drain(void) {
+    TEST_ASSERT_TRUE(MU_LOG_ISR(MU_LOG_LEVEL_INFO, "one"));
+    TEST_ASSERT_TRUE(MU_LOG_ISR(MU_LOG_LEVEL_ERROR, "two"));
+    TEST_ASSERT_EQUAL_size_t(0, s_n_lines);
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_isr_drain(0));
+    TEST_ASSERT_EQUAL_size_t(2, s_n_lines);
+    TEST_ASSERT_EQUAL_STRING("one", s_lines[0]);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_INFO, s_levels[0]);
+    TEST_ASSERT_EQUAL_STRING("two", s_lines[1]);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_ERROR, s_levels[1]);
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_isr_drain(0));
+}
+
+void test_isr_arguments_are_captured(void) {
+    int value = -42;
+
+    MU_LOG_ISR(MU_LOG_LEVEL_INFO, "v=%d h=%x s=%s c=%c", value, 0xbeefu, "ok",
+               'z');
+    value = 0; // the record holds a copy
+    mu_log_isr_drain(0);
+    TEST_ASSERT_EQUAL_STRING("v=-42 h=beef s=ok c=z", s_lines[0]);
+}
+
+void test_isr_respects_threshold(void) {
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_WARN);
+    TEST_ASSERT_FALSE(MU_LOG_ISR(MU_LOG_LEVEL_INFO, "filtered"));
+    TEST_ASSERT_TRUE(MU_LOG_ISR(MU_LOG_LEVEL_WARN, "kept"));
+    TEST_ASSERT_EQUAL_size_t(1, mu_log_isr_drain(0));
+    TEST_ASSERT_EQUAL_STRING("kept", s_lines[0]);
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_isr_dropped());
+}
+
+void test_isr_drain_limit(void) {
+    for (int i = 0; i < 5; i++) {
+        MU_LOG_ISR(MU_LOG_LEVEL_INFO, "r%d", i);
+    }
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_isr_drain(2));
+    TEST_ASSERT_EQUAL_STRING("r1", s_lines[1]);
+    TEST_ASSERT_EQUAL_size_t(3, mu_log_isr_drain(0));
+    TEST_ASSERT_EQUAL_STRING("r4", s_lines[4]);
+}
+
+void test_isr_overflow_drops_and_reports(void) {
+    for (int i = 0; i < MU_LOG_ISR_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(MU_LOG_ISR(MU_LOG_LEVEL_DEBUG, "fill"));
+    }
+    TEST_ASSERT_FALSE(MU_LOG_ISR(MU_LOG_LEVEL_DEBUG, "lost"));
+    TEST_ASSERT_FALSE(MU_LOG_ISR(MU_LOG_LEVEL_DEBUG, "lost"));
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_isr_dropped());
+
+    TEST_ASSERT_EQUAL_size_t(MU_LOG_ISR_CAPACITY, mu_log_isr_drain(0));
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, s_levels[0]);
+    TEST_ASSERT_EQUAL_STRING("mu_log_isr: 2 records dropped", s_lines[0]);
+    TEST_ASSERT_EQUAL_STRING("fill", s_lines[1]);
+
+    // reported once only
+    s_n_lines = 0;
+    MU_LOG_ISR(MU_LOG_LEVEL_DEBUG, "after");
+    mu_log_isr_drain(0);
+    TEST_ASSERT_EQUAL_size_t(1, s_n_lines);
+    TEST_ASSERT_EQUAL_STRING("after", s_lines[0]);
+}
+
+void test_isr_signal_hammer(void) {
+    struct itimerval timer = {{0, 50}, {0, 50}};
+    struct sigaction sa;
+    struct timespec start;
+    unsigned main_posted = 0;
+    size_t main_dropped = 0;
+
+    s_isr_posted = 0;
+    s_isr_next = 0;
+    s_isr_received = 0;
+    s_main_received = 0;
+    s_isr_last = -1;
+    s_main_last = -1;
+    s_in_order = true;
+    MU_LOG_SET_FN(hammer_sink);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = alarm_handler;
+    sigaction(SIGALRM, &sa, NULL);
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (elapsed_ms(&start) < HAMMER_MS) {
+        for (int i = 0; i < 8; i++) {
+            if (MU_LOG_ISR(MU_LOG_LEVEL_INFO, "main %u", main_posted)) {
+                main_posted++;
+            } else {
+                main_dropped++;
+            }
+        }
+        mu_log_isr_drain(4);
+    }
+
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_REAL, &timer, NULL);
+    signal(SIGALRM, SIG_DFL);
+    mu_log_isr_drain(0);
+
+    TEST_ASSERT_TRUE(s_in_order);
+    TEST_ASSERT_TRUE(s_isr_posted > 0);
+    TEST_ASSERT_EQUAL_size_t((size_t)s_isr_posted, s_isr_received);
+    TEST_ASSERT_EQUAL_size_t(main_posted, s_main_received);
+    TEST_ASSERT_EQUAL_size_t(mu_log_isr_dropped(),
+                             main_dropped + (s_isr_next - s_isr_posted));
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_isr_post_is_deferred_until_drain);
+    RUN_TEST(test_isr_arguments_are_captured);
+    RUN_TEST(test_isr_respects_threshold);
+    RUN_TEST(test_isr_drain_limit);
+    RUN_TEST(test_isr_overflow_drops_and_reports);
+    RUN_TEST(test_isr_signal_hammer);
+
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_mem.c
+ * @brief Unit tests for the allocator hooks and the bump arena.
+ *
+ * Tests run in order: the allocator can only be replaced before the first
+ * internal allocation, which the ISR test triggers.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_isr.h"
+#include "mu_log_mem.h"
+#include "unity.h"
+
+#include <stdint.h>
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+#define BUF_SIZE 4096
+
+static _Alignas(16) unsigned char s_buf[BUF_SIZE];
+static mu_log_arena_t s_arena;
+static size_t s_hook_allocs;
+static size_t s_hook_bytes;
+
+static void *counting_alloc(void *ctx, size_t size, size_t align) {
+    s_hook_allocs++;
+    s_hook_bytes += size;
+    return mu_log_arena_alloc((mu_log_arena_t *)ctx, size, align);
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    mu_log_arena_init(&s_arena, s_buf, sizeof(s_buf));
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_arena_aligns_and_accounts(void) {
+    unsigned char *a = mu_log_arena_alloc(&s_arena, 3, 1);
+    unsigned char *b = mu_log_arena_alloc(&s_arena, 8, 8);
+
+    TEST_ASSERT_EQUAL_PTR(s_buf, a);
+    TEST_ASSERT_EQUAL_PTR(s_buf + 8, b);
+    TEST_ASSERT_EQUAL_size_t(16, s_arena.used);
+    TEST_ASSERT_EQUAL_size_t(2, s_arena.n_allocs);
+}
+
+void test_arena_refuses_when_full(void) {
+    TEST_ASSERT_NOT_NULL(mu_log_arena_alloc(&s_arena, BUF_SIZE - 6, 1));
+    TEST_ASSERT_NULL(mu_log_arena_alloc(&s_arena, 4, 8)); // fits only unaligned
+    TEST_ASSERT_NULL(mu_log_arena_alloc(&s_arena, SIZE_MAX, 1));
+    TEST_ASSERT_EQUAL_size_t(2, s_arena.n_failed);
+    TEST_ASSERT_EQUAL_size_t(BUF_SIZE - 6, s_arena.used);
+
+    mu_log_arena_reset(&s_arena);
+    TEST_ASSERT_EQUAL_size_t(0, s_arena.used);
+    TEST_ASSERT_EQUAL_size_t(BUF_SIZE - 6, s_arena.high_water);
+}
+
+void test_arena_allocator_returns_last_block(void) {
+    mu_log_allocator_t a = mu_log_arena_allocator(&s_arena);
+    void *p = a.alloc(a.ctx, 32, 8);
+    void *q = a.alloc(a.ctx, 16, 8);
+
+    a.free(a.ctx, p, 32); // not the last block: kept
+    TEST_ASSERT_EQUAL_size_t(48, s_arena.used);
+    a.free(a.ctx, q, 16);
+    TEST_ASSERT_EQUAL_size_t(32, s_arena.used);
+}
+
+void test_internal_buffers_use_installed_allocator(void) {
+    mu_log_allocator_t a = {counting_alloc, NULL, &s_arena};
+    mu_log_arena_t before = *mu_log_default_arena();
+
+    TEST_ASSERT_TRUE(mu_log_set_allocator(&a));
+    mu_log_isr_init();
+
+    TEST_ASSERT_EQUAL_size_t(1, s_hook_allocs);
+    TEST_ASSERT_EQUAL_size_t(0, s_arena.n_failed);
+    TEST_ASSERT_EQUAL_size_t(s_hook_bytes, s_arena.used);
+    TEST_ASSERT_EQUAL_size_t(before.used, mu_log_default_arena()->used);
+
+    // fixed once anything has been allocated
+    TEST_ASSERT_FALSE(mu_log_set_allocator(NULL));
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_arena_aligns_and_accounts);
+    RUN_TEST(test_arena_refuses_when_full);
+    RUN_TEST(test_arena_allocator_returns_last_block);
+    RUN_TEST(test_internal_buffers_use_installed_allocator);
+
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_pipe.c
+ * @brief Unit tests for the page-gifting drain writer.
+ *
+ * The writer keeps one set of buffers per process, so the tests share it:
+ * the first runs over a pipe, the last closes it and reopens it on a file.
+ */
+
+// *****************************************************************************
+// Includes
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L // mkstemp()
+#endif
+
+#include "mu_log_pipe.h"
+#include "unity.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_LINES 20000 // several buffers' worth
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+#define PREFIX " INFO: "
+#else
+#define PREFIX "INFO: "
+#endif
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_pipe[2];
+static size_t s_bad;
+static size_t s_received;
+
+static size_t make_line(char *line, size_t size, int i) {
+    return (size_t)snprintf(line, size, "line %d of the pipe test", i);
+}
+
+/**
+ * @brief Reads the pipe to EOF, slowly at first, checking each line.
+ */
+static void *read_thread(void *arg) {
+    char expected[64];
+    char line[64];
+    size_t len = 0;
+    char buf[1000];
+    ssize_t n;
+    int i = 0;
+    struct timespec pause = {0, 20000000};
+
+    (void)arg;
+    nanosleep(&pause, NULL); // let the writer fill the pipe and recycle buffers
+    while ((n = read(s_pipe[0], buf, sizeof(buf))) > 0) {
+        s_received += (size_t)n;
+        for (ssize_t k = 0; k < n; k++) {
+            if (buf[k] != '\n') {
+                len += len < sizeof(line) - 1 ? 1 : 0;
+                line[len - 1] = buf[k];
+                continue;
+            }
+            line[len] = '\0';
+            snprintf(expected, sizeof(expected), PREFIX "line %d of the pipe test",
+                     i++);
+            s_bad += strcmp(expected, line) != 0;
+            len = 0;
+        }
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_pipe_gifts_pages_without_corruption(void) {
+    mu_log_pipe_stats_t stats;
+    pthread_t reader;
+    size_t sent = 0;
+    char line[64];
+
+    TEST_ASSERT_EQUAL_INT(0, pipe(s_pipe));
+    TEST_ASSERT_TRUE(mu_log_pipe_init(s_pipe[1], true));
+    TEST_ASSERT_FALSE(mu_log_pipe_init(s_pipe[1], true)); // already mapped
+    pthread_create(&reader, NULL, read_thread, NULL);
+    for (int i = 0; i < N_LINES; i++) {
+        size_t len = make_line(line, sizeof(line), i);
+        mu_log_pipe_writer(MU_LOG_LEVEL_INFO, line, len, NULL);
+        sent += strlen(PREFIX) + len + 1;
+        if (i % 200 == 0) {
+            // a partial buffer: its pages are still in the pipe when the
+            // rotation comes back to it, so it is remapped
+            TEST_ASSERT_TRUE(mu_log_pipe_flush());
+        }
+    }
+    mu_log_pipe_close();
+    close(s_pipe[1]);
+    pthread_join(reader, NULL);
+    close(s_pipe[0]);
+
+    mu_log_pipe_stats(&stats);
+    TEST_ASSERT_EQUAL_size_t(0, s_bad);
+    TEST_ASSERT_EQUAL_size_t(sent, s_received);
+    TEST_ASSERT_EQUAL_UINT64(sent, stats.spliced + stats.written);
+    TEST_ASSERT_TRUE(stats.spliced > stats.written);
+    TEST_ASSERT_TRUE(stats.remaps > 0);
+}
+
+void test_pipe_copies_to_a_file(void) {
+    char path[] = "/tmp/mu_log_pipe_XXXXXX";
+    char long_line[MU_LOG_PIPE_BUF_SIZE];
+    mu_log_pipe_stats_t stats;
+    char buf[128];
+    int fd = mkstemp(path);
+    ssize_t n;
+
+    TEST_ASSERT_TRUE(fd >= 0);
+    unlink(path);
+    TEST_ASSERT_TRUE(mu_log_pipe_init(fd, true)); // not a pipe: write()
+    mu_log_pipe_writer(MU_LOG_LEVEL_INFO, "first", 5, NULL);
+    mu_log_pipe_writer(MU_LOG_LEVEL_INFO, "second", 6, NULL);
+    TEST_ASSERT_EQUAL_INT64(0, lseek(fd, 0, SEEK_END)); // still buffered
+    TEST_ASSERT_TRUE(mu_log_pipe_flush());
+
+    memset(long_line, 'x', sizeof(long_line)); // longer than a buffer
+    mu_log_pipe_writer(MU_LOG_LEVEL_INFO, long_line, sizeof(long_line), NULL);
+    mu_log_pipe_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.spliced);
+    TEST_ASSERT_EQUAL_UINT64(2 * strlen(PREFIX) + 13 + strlen(PREFIX) +
+                                 sizeof(long_line) + 1,
+                             stats.written);
+
+    n = pread(fd, buf, sizeof(buf) - 1, 0);
+    buf[n < 0 ? 0 : n] = '\0';
+    TEST_ASSERT_EQUAL_STRING_LEN(PREFIX "first\n" PREFIX "second\n" PREFIX "xx",
+                                 buf, strlen(PREFIX) * 3 + 15);
+    mu_log_pipe_close();
+    close(fd);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pipe_gifts_pages_without_corruption);
+    RUN_TEST(test_pipe_copies_to_a_file);
+
+    return UNITY_END();
+}
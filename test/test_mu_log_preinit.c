@@ -0,0 +1,159 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_preinit.c
+ * @brief Unit tests for the pre-init buffer that holds records logged before
+ * a sink is set.
+ *
+ * The first test must run before anything installs a sink.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define LINE_MAX_LEN 64
+#define N_LINES 16
+
+// 40 characters: each buffered copy takes 42 of the MU_LOG_PREINIT_SIZE bytes
+#define FILLER "0123456789012345678901234567890123456789"
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static char s_lines[N_LINES][LINE_MAX_LEN];
+static mu_log_level_t s_levels[N_LINES];
+static size_t s_n_lines;
+
+static void record_line(mu_log_level_t level, const char *line) {
+    if (s_n_lines < N_LINES) {
+        snprintf(s_lines[s_n_lines], LINE_MAX_LEN, "%s", line);
+        s_levels[s_n_lines] = level;
+    }
+    s_n_lines++;
+}
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int capture_sink(mu_log_level_t level, const char *format, va_list ap) {
+    char line[LINE_MAX_LEN];
+    if (!MU_LOG_WILL_LOG(level)) {
+        return 0;
+    }
+    vsnprintf(line, sizeof(line), format, ap);
+    record_line(level, line);
+    return 1;
+}
+#else
+static int capture_sink(mu_log_level_t level, const char *message) {
+    if (!MU_LOG_WILL_LOG(level)) {
+        return 0;
+    }
+    record_line(level, message);
+    return 1;
+}
+#endif
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    memset(s_lines, 0, sizeof(s_lines));
+    s_n_lines = 0;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_preinit_buffers_until_first_sink(void) {
+    size_t n_filler = (MU_LOG_PREINIT_SIZE - 16) / 42;
+
+    TEST_ASSERT_TRUE(MU_LOG_GET_FN() == mu_log_preinit_fn);
+#ifdef MU_LOG_ENABLE_FORMATTED
+    MU_LOG_INFO("boot %d", 1);
+#else
+    MU_LOG_INFO("boot 1");
+#endif
+    MU_LOG_DEBUG("below threshold");
+    MU_LOG_ERROR("early");
+    for (size_t i = 0; i < n_filler + 2; i++) {
+        MU_LOG_INFO(FILLER);
+    }
+    TEST_ASSERT_EQUAL_size_t(2, mu_log_preinit_dropped());
+
+    MU_LOG_SET_FN(capture_sink);
+    TEST_ASSERT_EQUAL_size_t(n_filler + 3, s_n_lines);
+    TEST_ASSERT_EQUAL_STRING("boot 1", s_lines[0]);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_INFO, s_levels[0]);
+    TEST_ASSERT_EQUAL_STRING("early", s_lines[1]);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_ERROR, s_levels[1]);
+    TEST_ASSERT_EQUAL_STRING(FILLER, s_lines[2]);
+    TEST_ASSERT_EQUAL_STRING("mu_log: 2 early records dropped",
+                             s_lines[n_filler + 2]);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, s_levels[n_filler + 2]);
+    TEST_ASSERT_EQUAL_size_t(0, mu_log_preinit_dropped());
+}
+
+void test_preinit_replays_once(void) {
+    MU_LOG_SET_FN(capture_sink);
+    TEST_ASSERT_EQUAL_size_t(0, s_n_lines);
+    MU_LOG_INFO("live");
+    TEST_ASSERT_EQUAL_size_t(1, s_n_lines);
+}
+
+void test_preinit_can_be_reinstalled(void) {
+    MU_LOG_SET_FN(mu_log_preinit_fn);
+    MU_LOG_WARN("held");
+    TEST_ASSERT_EQUAL_size_t(0, s_n_lines);
+    MU_LOG_SET_FN(capture_sink);
+    TEST_ASSERT_EQUAL_size_t(1, s_n_lines);
+    TEST_ASSERT_EQUAL_STRING("held", s_lines[0]);
+}
+
+void test_mu_log_without_sink_is_safe(void) {
+    MU_LOG_SET_FN(NULL);
+    mu_log(MU_LOG_LEVEL_FATAL, "nowhere to go");
+    MU_LOG_FATAL("nowhere to go");
+    TEST_ASSERT_EQUAL_size_t(0, s_n_lines);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_preinit_buffers_until_first_sink);
+    RUN_TEST(test_preinit_replays_once);
+    RUN_TEST(test_preinit_can_be_reinstalled);
+    RUN_TEST(test_mu_log_without_sink_is_safe);
+
+    return UNITY_END();
+}
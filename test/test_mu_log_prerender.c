@@ -0,0 +1,149 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_prerender.c
+ * @brief Tests the pre-rendered literal lines of `MU_LOG_PRERENDER`.
+ *
+ * Self-contained, like test_mu_log_single_header.c, so the implementation is
+ * built with the same option.  In formatted mode the option has no effect
+ * and only the ordinary path is checked.
+ */
+
+// *****************************************************************************
+// Includes
+
+#define MU_LOG_PRERENDER
+#define MU_LOG_IMPLEMENTATION
+#include "mu_log.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static char s_message[64];
+static int s_calls;
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int capture_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)level;
+    vsnprintf(s_message, sizeof(s_message), format, ap);
+    return ++s_calls;
+}
+#else
+static int capture_sink(mu_log_level_t level, const char *message) {
+    (void)level;
+    snprintf(s_message, sizeof(s_message), "%s", message);
+    return ++s_calls;
+}
+
+/**
+ * @brief Runs `body` with stdout sent to a temporary file and returns what
+ * it wrote.
+ */
+static const char *capture_stdout(void (*body)(void)) {
+    static char text[128];
+    FILE *file = tmpfile();
+    int saved;
+    size_t n;
+
+    fflush(stdout);
+    saved = dup(STDOUT_FILENO);
+    dup2(fileno(file), STDOUT_FILENO);
+    body();
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+
+    rewind(file);
+    n = fread(text, 1, sizeof(text) - 1, file);
+    text[n] = '\0';
+    fclose(file);
+    return text;
+}
+
+static void log_literals(void) {
+    MU_LOG_INFO("cache warmed");
+    MU_LOG_DEBUG("filtered");
+    MU_LOG_ERROR("disk " "full");
+}
+
+static void log_runtime_message(void) {
+    const char *message = s_message;
+    MU_LOG(MU_LOG_LEVEL_WARN, message);
+}
+#endif
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    s_calls = 0;
+    s_message[0] = '\0';
+    MU_LOG_SET_FN(capture_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_other_sinks_get_the_bare_message(void) {
+    MU_LOG_INFO("cache warmed");
+    TEST_ASSERT_EQUAL_INT(1, s_calls);
+    TEST_ASSERT_EQUAL_STRING("cache warmed", s_message);
+    MU_LOG_DEBUG("filtered");
+    TEST_ASSERT_EQUAL_INT(1, s_calls);
+}
+
+#ifndef MU_LOG_ENABLE_FORMATTED
+void test_stdout_gets_the_prerendered_line(void) {
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+    TEST_ASSERT_EQUAL_STRING("INFO: cache warmed\nERROR: disk full\n",
+                             capture_stdout(log_literals));
+}
+
+void test_runtime_messages_take_the_ordinary_path(void) {
+    strcpy(s_message, "built at run time");
+    MU_LOG_SET_FN(mu_log_stdout_fn);
+    TEST_ASSERT_EQUAL_STRING("WARN: built at run time\n",
+                             capture_stdout(log_runtime_message));
+}
+#endif
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_other_sinks_get_the_bare_message);
+#ifndef MU_LOG_ENABLE_FORMATTED
+    RUN_TEST(test_stdout_gets_the_prerendered_line);
+    RUN_TEST(test_runtime_messages_take_the_ordinary_path);
+#endif
+
+    return UNITY_END();
+}
@@ -0,0 +1,229 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_route.c
+ * @brief Unit tests for cached per-call-site routing.
+ *
+ * Built, with the library, with `MU_LOG_ROUTES` and `MU_LOG_MODULES`.
+ */
+
+// *****************************************************************************
+// Includes
+
+#define MU_LOG_MODULE "net.tcp"
+
+#include "mu_log_cfg.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+enum { SINK_NET, SINK_ALL, SINK_DB, N_SINKS };
+
+#define N_ROUTERS 2
+#define N_PUBLISHES 5000
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_counts[N_SINKS];
+static mu_log_site_t s_shared_site = MU_LOG_SITE_INIT;
+static atomic_bool s_stop;
+static atomic_int s_bad_routes;
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+#define DEFINE_SINK(name, index)                                               \
+    static int name(mu_log_level_t level, const char *format, va_list ap) {    \
+        (void)level;                                                           \
+        (void)format;                                                          \
+        (void)ap;                                                              \
+        s_counts[index]++;                                                     \
+        return 1;                                                              \
+    }
+#else
+#define DEFINE_SINK(name, index)                                               \
+    static int name(mu_log_level_t level, const char *message) {               \
+        (void)level;                                                           \
+        (void)message;                                                         \
+        s_counts[index]++;                                                     \
+        return 1;                                                              \
+    }
+#endif
+
+DEFINE_SINK(net_sink, SINK_NET)
+DEFINE_SINK(all_sink, SINK_ALL)
+DEFINE_SINK(db_sink, SINK_DB)
+
+/**
+ * @brief One call site, so repeated calls share its cached routes.
+ */
+static void log_at(mu_log_level_t level) {
+    MU_LOG(level, "routed");
+}
+
+/**
+ * @brief Reads the shared site's INFO routes while the main thread publishes;
+ * each answer must come from one of the two configurations it alternates.
+ */
+static void *router_thread(void *arg) {
+    int reader = mu_log_cfg_register_reader();
+
+    (void)arg;
+    while (!atomic_load(&s_stop)) {
+        unsigned routes = mu_log_site_routes(&s_shared_site, MU_LOG_LEVEL_INFO);
+        if (routes != (1u << SINK_NET) &&
+            routes != ((1u << SINK_NET) | (1u << SINK_ALL))) {
+            atomic_fetch_add(&s_bad_routes, 1);
+        }
+        mu_log_cfg_quiescent(reader);
+    }
+    mu_log_cfg_unregister_reader(reader);
+    return NULL;
+}
+
+static mu_log_config_t three_sinks(void) {
+    mu_log_config_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.n_sinks = 3;
+    config.sinks[SINK_NET] = (mu_log_cfg_sink_t){net_sink, MU_LOG_LEVEL_TRACE,
+                                                 "net"};
+    config.sinks[SINK_ALL] = (mu_log_cfg_sink_t){all_sink, MU_LOG_LEVEL_WARN,
+                                                 ""};
+    config.sinks[SINK_DB] = (mu_log_cfg_sink_t){db_sink, MU_LOG_LEVEL_TRACE,
+                                                "db"};
+    return config;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    mu_log_config_t config = three_sinks();
+
+    memset(s_counts, 0, sizeof(s_counts));
+    TEST_ASSERT_TRUE(mu_log_cfg_init());
+    TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_route_by_sink_threshold_and_module(void) {
+    log_at(MU_LOG_LEVEL_INFO);
+    TEST_ASSERT_EQUAL_INT(1, s_counts[SINK_NET]);
+    TEST_ASSERT_EQUAL_INT(0, s_counts[SINK_ALL]);
+
+    log_at(MU_LOG_LEVEL_WARN);
+    TEST_ASSERT_EQUAL_INT(2, s_counts[SINK_NET]);
+    TEST_ASSERT_EQUAL_INT(1, s_counts[SINK_ALL]);
+    TEST_ASSERT_EQUAL_INT(0, s_counts[SINK_DB]);
+}
+
+void test_route_is_cached_per_generation(void) {
+    static mu_log_site_t site = MU_LOG_SITE_INIT;
+    mu_log_config_t config = three_sinks();
+
+    TEST_ASSERT_EQUAL_UINT(1u << SINK_NET,
+                           mu_log_site_routes(&site, MU_LOG_LEVEL_INFO));
+    TEST_ASSERT_EQUAL_UINT(mu_log_module_generation, site.generation);
+
+    // the cache answers until the generation moves
+    site.routes[MU_LOG_LEVEL_INFO] = 1u << SINK_DB;
+    TEST_ASSERT_EQUAL_UINT(1u << SINK_DB,
+                           mu_log_site_routes(&site, MU_LOG_LEVEL_INFO));
+
+    config.sinks[SINK_ALL].threshold = MU_LOG_LEVEL_TRACE;
+    TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+    TEST_ASSERT_EQUAL_UINT((1u << SINK_NET) | (1u << SINK_ALL),
+                           mu_log_site_routes(&site, MU_LOG_LEVEL_INFO));
+}
+
+void test_route_shared_site_under_publish(void) {
+    pthread_t threads[N_ROUTERS];
+    mu_log_config_t config = three_sinks();
+
+    atomic_store(&s_stop, false);
+    atomic_store(&s_bad_routes, 0);
+    for (int t = 0; t < N_ROUTERS; t++) {
+        pthread_create(&threads[t], NULL, router_thread, NULL);
+    }
+    for (int i = 0; i < N_PUBLISHES; i++) {
+        config.sinks[SINK_ALL].threshold =
+            (i & 1) ? MU_LOG_LEVEL_TRACE : MU_LOG_LEVEL_WARN;
+        mu_log_cfg_publish(&config); // may fail while a snapshot is held
+    }
+    atomic_store(&s_stop, true);
+    for (int t = 0; t < N_ROUTERS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&s_bad_routes));
+}
+
+void test_route_follows_module_rules(void) {
+    mu_log_config_t config = three_sinks();
+
+    config.n_modules = 1;
+    strcpy(config.modules[0].name, "net");
+    config.modules[0].threshold = MU_LOG_LEVEL_ERROR;
+    TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+
+    TEST_ASSERT_FALSE(MU_LOG_WILL_LOG(MU_LOG_LEVEL_WARN));
+    TEST_ASSERT_TRUE(MU_LOG_WILL_LOG(MU_LOG_LEVEL_ERROR));
+    log_at(MU_LOG_LEVEL_WARN);
+    log_at(MU_LOG_LEVEL_ERROR);
+    TEST_ASSERT_EQUAL_INT(1, s_counts[SINK_NET]);
+    TEST_ASSERT_EQUAL_INT(1, s_counts[SINK_ALL]);
+}
+
+void test_cfg_fn_skips_module_sinks(void) {
+    TEST_ASSERT_EQUAL_UINT(1u << SINK_DB,
+                           mu_log_cfg_sink_mask(mu_log_cfg_current(), "db.pool",
+                                                MU_LOG_LEVEL_INFO));
+
+    // unrouted records belong to the default module
+    MU_LOG_SET_FN(mu_log_cfg_fn);
+    mu_log(MU_LOG_LEVEL_ERROR, "direct");
+    TEST_ASSERT_EQUAL_INT(0, s_counts[SINK_NET]);
+    TEST_ASSERT_EQUAL_INT(1, s_counts[SINK_ALL]);
+    TEST_ASSERT_EQUAL_INT(0, s_counts[SINK_DB]);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_route_by_sink_threshold_and_module);
+    RUN_TEST(test_route_is_cached_per_generation);
+    RUN_TEST(test_route_shared_site_under_publish);
+    RUN_TEST(test_route_follows_module_rules);
+    RUN_TEST(test_cfg_fn_skips_module_sinks);
+
+    return UNITY_END();
+}
@@ -0,0 +1,235 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_shm.c
+ * @brief Unit tests for the shared-memory control page.
+ *
+ * Built, with the library, with `MU_LOG_SHM` and `MU_LOG_MODULES`.  The test
+ * plays both sides: it logs, and attaches to its own page as a tool would.
+ */
+
+// *****************************************************************************
+// Includes
+
+#define MU_LOG_MODULE "shm.test"
+
+#include "mu_log_shm.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_RESOLVERS 4
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_count;
+static int s_line_a;
+static int s_line_b;
+static mu_log_shm_page_t *s_tool; // the page as an external tool maps it
+static int s_line_c;
+static mu_log_site_t s_shared_site = MU_LOG_SITE_INIT;
+static pthread_barrier_t s_start;
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int count_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)level;
+    (void)format;
+    (void)ap;
+    s_count++;
+    return 1;
+}
+#else
+static int count_sink(mu_log_level_t level, const char *message) {
+    (void)level;
+    (void)message;
+    s_count++;
+    return 1;
+}
+#endif
+
+static void log_a(void) {
+    s_line_a = __LINE__ + 1;
+    MU_LOG_INFO("a");
+}
+
+static void log_c(bool emit) {
+    s_line_c = __LINE__ + 2;
+    if (emit) {
+        MU_LOG_INFO("c");
+    }
+}
+
+static void log_b(void) {
+    s_line_b = __LINE__ + 1;
+    MU_LOG_INFO("b");
+}
+
+static void *resolve_thread(void *arg) {
+    (void)arg;
+    pthread_barrier_wait(&s_start); // reach the unlisted site together
+    mu_log_site_will_log(&s_shared_site, MU_LOG_LEVEL_INFO);
+    return NULL;
+}
+
+static int count_sites(int line) {
+    int n = 0;
+
+    for (uint32_t i = 0; i < s_tool->n_sites; i++) {
+        n += s_tool->sites[i].line == (uint32_t)line ? 1 : 0;
+    }
+    return n;
+}
+
+static int find_site(int line) {
+    for (uint32_t i = 0; i < s_tool->n_sites; i++) {
+        if (strcmp(s_tool->sites[i].file, "test_mu_log_shm.c") == 0 &&
+            s_tool->sites[i].line == (uint32_t)line) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    s_count = 0;
+    MU_LOG_SET_FN(count_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_shm_page_is_shared(void) {
+    TEST_ASSERT_NULL(mu_log_shm_attach(getpid())); // not published yet
+    TEST_ASSERT_TRUE(mu_log_shm_init());
+    s_tool = mu_log_shm_attach(getpid());
+    TEST_ASSERT_NOT_NULL(s_tool);
+    TEST_ASSERT_TRUE(s_tool != &mu_log_shm_page);
+    TEST_ASSERT_EQUAL_INT(getpid(), s_tool->pid);
+
+    s_tool->threshold = MU_LOG_LEVEL_ERROR;
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_ERROR, MU_LOG_GET_THRESHOLD());
+    TEST_ASSERT_FALSE(MU_LOG_WILL_LOG(MU_LOG_LEVEL_WARN));
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_TRACE);
+    TEST_ASSERT_EQUAL_UINT32(MU_LOG_LEVEL_TRACE, s_tool->threshold);
+}
+
+void test_shm_sites_are_listed_and_toggled(void) {
+    int a, b;
+
+    log_a();
+    log_b();
+    TEST_ASSERT_EQUAL_INT(2, s_count);
+    a = find_site(s_line_a);
+    b = find_site(s_line_b);
+    TEST_ASSERT_TRUE(a >= 0 && b >= 0 && a != b);
+    TEST_ASSERT_EQUAL_STRING("shm.test",
+                             s_tool->modules[s_tool->sites[a].module].name);
+
+    mu_log_shm_set_site(s_tool, a, false);
+    log_a();
+    log_b();
+    TEST_ASSERT_EQUAL_INT(3, s_count);
+
+    mu_log_shm_set_site(s_tool, a, true);
+    log_a();
+    TEST_ASSERT_EQUAL_INT(4, s_count);
+}
+
+void test_shm_site_listed_once_by_racing_threads(void) {
+    pthread_t threads[N_RESOLVERS];
+
+    pthread_barrier_init(&s_start, NULL, N_RESOLVERS);
+    for (int t = 0; t < N_RESOLVERS; t++) {
+        pthread_create(&threads[t], NULL, resolve_thread, NULL);
+    }
+    for (int t = 0; t < N_RESOLVERS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&s_start);
+    TEST_ASSERT_EQUAL_INT(1, count_sites((int)s_shared_site.line));
+}
+
+void test_shm_fork_child_lists_into_shared_page(void) {
+    uint32_t n_sites = s_tool->n_sites;
+    int status;
+    pid_t pid = fork();
+
+    if (pid == 0) {
+        log_c(true);
+        _exit(0);
+    }
+    TEST_ASSERT_TRUE(pid > 0);
+    TEST_ASSERT_EQUAL_INT(pid, waitpid(pid, &status, 0));
+    log_c(false);
+    TEST_ASSERT_EQUAL_UINT32(n_sites + 1, s_tool->n_sites);
+    TEST_ASSERT_EQUAL_INT(1, count_sites(s_line_c));
+    TEST_ASSERT_EQUAL_UINT32(0, s_tool->tables_lock);
+}
+
+void test_shm_module_override(void) {
+    int module = s_tool->sites[find_site(s_line_a)].module;
+
+    mu_log_shm_set_module(s_tool, module, MU_LOG_LEVEL_ERROR);
+    log_a();
+    MU_LOG_ERROR("kept");
+    TEST_ASSERT_EQUAL_INT(1, s_count);
+
+    mu_log_shm_set_module(s_tool, module, MU_LOG_SHM_NO_OVERRIDE);
+    log_a();
+    TEST_ASSERT_EQUAL_INT(2, s_count);
+}
+
+void test_shm_close_removes_the_name(void) {
+    mu_log_shm_detach(s_tool);
+    mu_log_shm_close();
+    TEST_ASSERT_NULL(mu_log_shm_attach(getpid()));
+    log_a(); // the page itself is still in use
+    TEST_ASSERT_EQUAL_INT(1, s_count);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_shm_page_is_shared);
+    RUN_TEST(test_shm_sites_are_listed_and_toggled);
+    RUN_TEST(test_shm_site_listed_once_by_racing_threads);
+    RUN_TEST(test_shm_fork_child_lists_into_shared_page);
+    RUN_TEST(test_shm_module_override);
+    RUN_TEST(test_shm_close_removes_the_name);
+
+    return UNITY_END();
+}
@@ -0,0 +1,110 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_single_header.c
+ * @brief Tests the single-header build and the inline filter in the macros.
+ *
+ * Linked without src/mu_log.c: the implementation comes from defining
+ * MU_LOG_IMPLEMENTATION here, after mu_log.h has already been included once.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log.h"
+#include "unity.h"
+
+#define MU_LOG_IMPLEMENTATION
+#include "mu_log.h"
+
+#include <stddef.h>
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_calls;
+
+// Unlike the other test sinks, this one does not check the threshold itself.
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int counting_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)level;
+    (void)format;
+    (void)ap;
+    return ++s_calls;
+}
+#else
+static int counting_sink(mu_log_level_t level, const char *message) {
+    (void)level;
+    (void)message;
+    return ++s_calls;
+}
+#endif
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    s_calls = 0;
+    MU_LOG_SET_FN(counting_sink);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_WARN);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_macros_filter_before_calling_sink(void) {
+    MU_LOG_INFO("suppressed");
+    MU_LOG(MU_LOG_LEVEL_DEBUG, "suppressed");
+    TEST_ASSERT_EQUAL_INT(0, s_calls);
+
+    MU_LOG_WARN("emitted");
+    MU_LOG(MU_LOG_LEVEL_ERROR, "emitted");
+    TEST_ASSERT_EQUAL_INT(2, s_calls);
+}
+
+void test_macros_without_sink_are_silent(void) {
+    MU_LOG_SET_FN(NULL);
+    TEST_ASSERT_FALSE(MU_LOG_WILL_LOG(MU_LOG_LEVEL_FATAL));
+    MU_LOG_FATAL("no sink");
+    TEST_ASSERT_EQUAL_INT(0, s_calls);
+}
+
+void test_will_log_reads_logger_state(void) {
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, mu_log_logger.threshold);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_TRACE);
+    TEST_ASSERT_TRUE(MU_LOG_WILL_LOG(MU_LOG_LEVEL_TRACE));
+    TEST_ASSERT_EQUAL_STRING("ERROR", MU_LOG_LEVEL_NAME(MU_LOG_LEVEL_ERROR));
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_macros_filter_before_calling_sink);
+    RUN_TEST(test_macros_without_sink_are_silent);
+    RUN_TEST(test_will_log_reads_logger_state);
+
+    return UNITY_END();
+}
@@ -0,0 +1,216 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_spec.c
+ * @brief Unit tests for per-module levels set from a spec string.
+ *
+ * Built with `MU_LOG_MODULES`; this file's call sites belong to "net.tcp".
+ */
+
+// *****************************************************************************
+// Includes
+
+#define MU_LOG_MODULES
+#define MU_LOG_MODULE "net.tcp"
+
+#include "mu_log_spec.h"
+#include "unity.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SPEC_FILE "/tmp/test_mu_log_spec.conf"
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_count;
+static uint64_t s_now_ms;
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int count_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)level;
+    (void)format;
+    (void)ap;
+    s_count++;
+    return 1;
+}
+#else
+static int count_sink(mu_log_level_t level, const char *message) {
+    (void)level;
+    (void)message;
+    s_count++;
+    return 1;
+}
+#endif
+
+static uint64_t fake_clock(void) {
+    return s_now_ms;
+}
+
+static void write_spec_file(const char *spec) {
+    FILE *file = fopen(SPEC_FILE ".tmp", "w");
+    fputs(spec, file);
+    fputs("\n", file);
+    fclose(file);
+    rename(SPEC_FILE ".tmp", SPEC_FILE); // as editors do
+}
+
+/**
+ * @brief Counts the levels at which this file's sites log.
+ */
+static int logged_levels(void) {
+    s_count = 0;
+    MU_LOG_TRACE("t");
+    MU_LOG_DEBUG("d");
+    MU_LOG_INFO("i");
+    MU_LOG_WARN("w");
+    MU_LOG_ERROR("e");
+    MU_LOG_FATAL("f");
+    return s_count;
+}
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    mu_log_config_t config = {1, {{count_sink, MU_LOG_LEVEL_TRACE}}};
+
+    TEST_ASSERT_TRUE(mu_log_cfg_init());
+    TEST_ASSERT_TRUE(mu_log_cfg_publish(&config));
+    MU_LOG_SET_FN(mu_log_cfg_fn);
+    mu_log_spec_set_clock(fake_clock);
+    s_now_ms = 1000;
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_spec_parse(void) {
+    mu_log_config_t config = {0};
+
+    TEST_ASSERT_TRUE(mu_log_spec_parse(" *=warn, net = Debug,db.pool=TRACE,",
+                                       &config));
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, config.module_default);
+    TEST_ASSERT_EQUAL_size_t(2, config.n_modules);
+    TEST_ASSERT_EQUAL_STRING("net", config.modules[0].name);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_DEBUG, config.modules[0].threshold);
+    TEST_ASSERT_EQUAL_STRING("db.pool", config.modules[1].name);
+    TEST_ASSERT_EQUAL_UINT64(0, config.modules[1].expires);
+
+    TEST_ASSERT_TRUE(mu_log_spec_parse("error,net=debug:30", &config));
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_ERROR, config.module_default);
+    TEST_ASSERT_EQUAL_UINT64(31000, config.modules[0].expires);
+
+    TEST_ASSERT_FALSE(mu_log_spec_parse("net=loud", &config));
+    TEST_ASSERT_FALSE(mu_log_spec_parse("=debug", &config));
+    TEST_ASSERT_FALSE(mu_log_spec_parse("net", &config));
+    TEST_ASSERT_FALSE(mu_log_spec_parse("*=debug:10", &config));
+    TEST_ASSERT_FALSE(mu_log_spec_parse("net=debug:soon", &config));
+    TEST_ASSERT_FALSE(
+        mu_log_spec_parse("a=info,b=info,c=info,d=info,e=info,f=info,g=info,"
+                          "h=info,i=info", &config));
+    TEST_ASSERT_EQUAL_size_t(1, config.n_modules); // unchanged on failure
+}
+
+void test_spec_module_thresholds(void) {
+    mu_log_module_t db = {"db.pool", 0, MU_LOG_LEVEL_TRACE};
+    mu_log_module_t dbx = {"dbx", 0, MU_LOG_LEVEL_TRACE};
+
+    TEST_ASSERT_TRUE(mu_log_spec_apply("*=warn,net=debug,db=error,db.pool=info"));
+    TEST_ASSERT_EQUAL_INT(5, logged_levels()); // net.tcp inherits net=debug
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_DEBUG, MU_LOG_GET_THRESHOLD());
+    TEST_ASSERT_TRUE(mu_log_module_will_log(&db, MU_LOG_LEVEL_INFO));
+    TEST_ASSERT_FALSE(mu_log_module_will_log(&db, MU_LOG_LEVEL_DEBUG));
+    TEST_ASSERT_TRUE(mu_log_module_will_log(&dbx, MU_LOG_LEVEL_WARN)); // not "db"
+
+    TEST_ASSERT_TRUE(mu_log_spec_apply("net.tcp=fatal"));
+    TEST_ASSERT_EQUAL_INT(1, logged_levels());
+    TEST_ASSERT_FALSE(mu_log_spec_apply("net.tcp=bogus"));
+    TEST_ASSERT_EQUAL_INT(1, logged_levels());
+}
+
+void test_spec_rules_expire(void) {
+    TEST_ASSERT_TRUE(mu_log_spec_apply("*=info,net=trace:10"));
+    TEST_ASSERT_EQUAL_INT(6, logged_levels());
+    s_now_ms += 9999;
+    TEST_ASSERT_FALSE(mu_log_spec_poll());
+    TEST_ASSERT_EQUAL_INT(6, logged_levels());
+    s_now_ms += 1;
+    TEST_ASSERT_TRUE(mu_log_spec_poll());
+    TEST_ASSERT_EQUAL_INT(4, logged_levels()); // back to *=info
+}
+
+void test_spec_from_environment_and_sighup(void) {
+    setenv("MU_LOG", "net=error", 1);
+    TEST_ASSERT_TRUE(mu_log_spec_init());
+    TEST_ASSERT_EQUAL_INT(2, logged_levels());
+
+    setenv("MU_LOG", "net=info", 1);
+    TEST_ASSERT_TRUE(mu_log_spec_watch_sighup());
+    TEST_ASSERT_FALSE(mu_log_spec_poll());
+    raise(SIGHUP);
+    TEST_ASSERT_TRUE(mu_log_spec_poll());
+    TEST_ASSERT_EQUAL_INT(4, logged_levels());
+    signal(SIGHUP, SIG_DFL);
+    unsetenv("MU_LOG");
+}
+
+void test_spec_watched_file(void) {
+    struct timespec pause = {0, 1000000};
+    bool reloaded = false;
+
+    write_spec_file("*=info, net=warn");
+    TEST_ASSERT_TRUE(mu_log_spec_watch_file(SPEC_FILE));
+    TEST_ASSERT_EQUAL_INT(3, logged_levels());
+
+    write_spec_file("net=trace");
+    for (int i = 0; i < 1000 && !reloaded; i++) {
+        reloaded = mu_log_spec_poll();
+        nanosleep(&pause, NULL);
+    }
+    TEST_ASSERT_TRUE(reloaded);
+    TEST_ASSERT_EQUAL_INT(6, logged_levels());
+    remove(SPEC_FILE);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spec_parse);
+    RUN_TEST(test_spec_module_thresholds);
+    RUN_TEST(test_spec_rules_expire);
+    RUN_TEST(test_spec_from_environment_and_sighup);
+    RUN_TEST(test_spec_watched_file);
+
+    return UNITY_END();
+}
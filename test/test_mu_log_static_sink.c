@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file test_mu_log_static_sink.c
+ * @brief Tests a build with the sink bound at compile time.
+ *
+ * Like test_mu_log_single_header.c, this file compiles its own copy of the
+ * implementation, here with MU_LOG_STATIC_SINK naming the sink below.
+ */
+
+// *****************************************************************************
+// Includes
+
+#define MU_LOG_STATIC_SINK static_sink
+#define MU_LOG_IMPLEMENTATION
+#include "mu_log.h"
+#include "unity.h"
+
+#include <stddef.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private (static) storage and helpers
+
+static int s_calls;
+static mu_log_level_t s_last_level;
+static const char *s_last_text;
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+int static_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)ap;
+    s_last_level = level;
+    s_last_text = format;
+    return ++s_calls;
+}
+#else
+int static_sink(mu_log_level_t level, const char *message) {
+    s_last_level = level;
+    s_last_text = message;
+    return ++s_calls;
+}
+#endif
+
+#ifdef MU_LOG_ENABLE_FORMATTED
+static int other_sink(mu_log_level_t level, const char *format, va_list ap) {
+    (void)level;
+    (void)format;
+    (void)ap;
+    return 0;
+}
+#else
+static int other_sink(mu_log_level_t level, const char *message) {
+    (void)level;
+    (void)message;
+    return 0;
+}
+#endif
+
+// *****************************************************************************
+// Setup & Teardown
+
+void setUp(void) {
+    s_calls = 0;
+    s_last_text = NULL;
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_INFO);
+}
+
+void tearDown(void) {}
+
+// *****************************************************************************
+// Unit Tests
+
+void test_static_sink_is_bound_without_set_fn(void) {
+    TEST_ASSERT_TRUE(MU_LOG_WILL_LOG(MU_LOG_LEVEL_INFO));
+    TEST_ASSERT_TRUE(MU_LOG_GET_FN() == static_sink);
+
+    MU_LOG_WARN("bound");
+    TEST_ASSERT_EQUAL_INT(1, s_calls);
+    TEST_ASSERT_EQUAL_INT(MU_LOG_LEVEL_WARN, s_last_level);
+    TEST_ASSERT_EQUAL_STRING("bound", s_last_text);
+}
+
+void test_static_sink_respects_threshold(void) {
+    MU_LOG_DEBUG("suppressed");
+    TEST_ASSERT_EQUAL_INT(0, s_calls);
+    MU_LOG_SET_THRESHOLD(MU_LOG_LEVEL_TRACE);
+    MU_LOG_DEBUG("emitted");
+    TEST_ASSERT_EQUAL_INT(1, s_calls);
+}
+
+void test_static_sink_ignores_set_fn(void) {
+    MU_LOG_SET_FN(other_sink);
+    MU_LOG_ERROR("still bound");
+    TEST_ASSERT_EQUAL_INT(1, s_calls);
+    TEST_ASSERT_TRUE(MU_LOG_GET_FN() == static_sink);
+}
+
+// *****************************************************************************
+// Test Runner
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_static_sink_is_bound_without_set_fn);
+    RUN_TEST(test_static_sink_respects_threshold);
+    RUN_TEST(test_static_sink_ignores_set_fn);
+
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ */
+
+/**
+ * @file mu_log_ctl.c
+ * @brief Lists and changes the log levels of a running process through its
+ * shared control page (see mu_log_shm.h).
+ *
+ * usage:
+ *   mu_log_ctl <pid>                            list threshold, modules, sites
+ *   mu_log_ctl <pid> level <level>              set the global threshold
+ *   mu_log_ctl <pid> module <name> <level|default>
+ *   mu_log_ctl <pid> site <index|file:line> on|off
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_log_shm.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static int usage(void);
+static void list(const mu_log_shm_page_t *page);
+static const char *level_name(int level);
+static int parse_level(const char *text);
+static int find_module(const mu_log_shm_page_t *page, const char *name);
+static int find_site(const mu_log_shm_page_t *page, const char *spec);
+
+// *****************************************************************************
+// Public code
+
+int main(int argc, char *argv[]) {
+    mu_log_shm_page_t *page;
+    int status = 0;
+
+    if (argc < 2) {
+        return usage();
+    }
+    page = mu_log_shm_attach(atoi(argv[1]));
+    if (page == NULL) {
+        fprintf(stderr, "mu_log_ctl: no control page for pid %s\n", argv[1]);
+        return 1;
+    }
+
+    if (argc == 2) {
+        list(page);
+    } else if (argc == 4 && strcmp(argv[2], "level") == 0) {
+        int level = parse_level(argv[3]);
+        if (level < 0) {
+            status = usage();
+        } else {
+            page->threshold = (uint32_t)level;
+        }
+    } else if (argc == 5 && strcmp(argv[2], "module") == 0) {
+        int module = find_module(page, argv[3]);
+        int level = strcmp(argv[4], "default") == 0 ? MU_LOG_SHM_NO_OVERRIDE
+                                                     : parse_level(argv[4]);
+        if (module < 0 || level < MU_LOG_SHM_NO_OVERRIDE) {
+            fprintf(stderr, "mu_log_ctl: unknown module or level\n");
+            status = 1;
+        } else {
+            mu_log_shm_set_module(page, module, level);
+        }
+    } else if (argc == 5 && strcmp(argv[2], "site") == 0) {
+        int site = find_site(page, argv[3]);
+        bool on = strcmp(argv[4], "on") == 0;
+        if (site < 0 || (!on && strcmp(argv[4], "off") != 0)) {
+            fprintf(stderr, "mu_log_ctl: unknown site or state\n");
+            status = 1;
+        } else {
+            mu_log_shm_set_site(page, site, on);
+        }
+    } else {
+        status = usage();
+    }
+
+    mu_log_shm_detach(page);
+    return status;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int usage(void) {
+    fprintf(stderr,
+            "usage: mu_log_ctl <pid>\n"
+            "       mu_log_ctl <pid> level <level>\n"
+            "       mu_log_ctl <pid> module <name> <level|default>\n"
+            "       mu_log_ctl <pid> site <index|file:line> on|off\n");
+    return 2;
+}
+
+static void list(const mu_log_shm_page_t *page) {
+    printf("pid %d  threshold %s\n", (int)page->pid,
+           level_name((int)page->threshold));
+    printf("modules:\n");
+    for (uint32_t i = 0; i < page->n_modules; i++) {
+        const mu_log_shm_module_t *module = &page->modules[i];
+        printf("  %-24s %s\n", module->name[0] ? module->name : "(default)",
+               module->threshold == MU_LOG_SHM_NO_OVERRIDE
+                   ? "default"
+                   : level_name((int)module->threshold));
+    }
+    printf("sites:\n");
+    for (uint32_t i = 0; i < page->n_sites; i++) {
+        const mu_log_shm_site_t *site = &page->sites[i];
+        printf("  %3u  %s:%u  %s  %s\n", (unsigned)i, site->file,
+               (unsigned)site->line,
+               site->module >= 0 ? page->modules[site->module].name : "-",
+               site->enabled ? "on" : "off");
+    }
+}
+
+static const char *level_name(int level) {
+    return level <= MU_LOG_LEVEL_FATAL ? mu_log_level_name((mu_log_level_t)level)
+                                       : "OFF";
+}
+
+static int parse_level(const char *text) {
+    for (int level = MU_LOG_LEVEL_TRACE; level <= MU_LOG_LEVEL_FATAL; level++) {
+        if (strcasecmp(text, mu_log_level_name((mu_log_level_t)level)) == 0) {
+            return level;
+        }
+    }
+    return -2;
+}
+
+static int find_module(const mu_log_shm_page_t *page, const char *name) {
+    for (uint32_t i = 0; i < page->n_modules; i++) {
+        if (strcmp(page->modules[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static int find_site(const mu_log_shm_page_t *page, const char *spec) {
+    const char *colon = strrchr(spec, ':');
+
+    if (colon == NULL) {
+        int index = atoi(spec);
+        return index >= 0 && (uint32_t)index < page->n_sites ? index : -1;
+    }
+    for (uint32_t i = 0; i < page->n_sites; i++) {
+        const mu_log_shm_site_t *site = &page->sites[i];
+        if (strlen(site->file) == (size_t)(colon - spec) &&
+            strncmp(site->file, spec, (size_t)(colon - spec)) == 0 &&
+            site->line == (uint32_t)atoi(colon + 1)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}